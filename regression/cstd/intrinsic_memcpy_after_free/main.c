@@ -0,0 +1,13 @@
+#include <stdlib.h>
+#include <string.h>
+
+int main()
+{
+  char a[4] = {1, 2, 3, 4};
+  char *b = malloc(sizeof(a));
+  if(!b)
+    return 0;
+  free(b);
+  memcpy(b, a, sizeof(a));
+  return 0;
+}
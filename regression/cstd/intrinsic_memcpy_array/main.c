@@ -0,0 +1,33 @@
+#include <assert.h>
+#include <string.h>
+
+int nondet_int();
+
+struct record
+{
+  int x;
+  char c[3];
+};
+
+int main()
+{
+  // Slices of arrays
+  int a[512], b[512];
+  a[10] = nondet_int();
+  a[11] = 7;
+  memcpy(b + 100, a + 10, 2 * sizeof(int));
+  assert(b[100] == a[10]);
+  assert(b[101] == 7);
+
+  // Whole objects
+  struct record s = {1, "ab"}, t;
+  memcpy(&t, &s, sizeof(s));
+  assert(t.x == 1 && t.c[1] == 'b');
+
+  // The bytes of an object into a buffer
+  char buf[sizeof(int)];
+  int v = 0x01020304;
+  memcpy(buf, &v, sizeof(v));
+  assert(buf[0] == 4 || buf[0] == 1);
+  return 0;
+}
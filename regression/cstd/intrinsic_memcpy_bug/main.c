@@ -0,0 +1,8 @@
+#include <string.h>
+
+int main()
+{
+  int a[4] = {1, 2, 3, 4}, b[2];
+  memcpy(b, a, sizeof(a));
+  return b[0];
+}
@@ -0,0 +1,11 @@
+#include <assert.h>
+#include <string.h>
+
+int main()
+{
+  char str[] = "memmove can be very useful......";
+  char expected[] = "memmove can be very very useful.";
+  memmove(str + 20, str + 15, 11);
+  assert(memcmp(str, expected, sizeof(str)) == 0);
+  return 0;
+}
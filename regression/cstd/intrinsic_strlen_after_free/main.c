@@ -0,0 +1,12 @@
+#include <stdlib.h>
+#include <string.h>
+
+int main()
+{
+  char *s = malloc(4);
+  if(!s)
+    return 0;
+  strcpy(s, "abc");
+  free(s);
+  return strlen(s);
+}
@@ -0,0 +1,19 @@
+#include <assert.h>
+#include <string.h>
+
+char nondet_char();
+
+int main()
+{
+  char s[64] = "hello";
+  char t[8] = "help";
+  assert(strlen(s) == 5);
+  assert(memcmp(s, t, 3) == 0);
+  assert(memcmp(s, t, 4) < 0);
+
+  s[5] = nondet_char();
+  s[6] = '\0';
+  size_t n = strlen(s);
+  assert(n == 5 || n == 6);
+  return 0;
+}
@@ -0,0 +1,6 @@
+#include <cassert>
+
+int add(int x, int y)
+{
+  return x + y;
+}
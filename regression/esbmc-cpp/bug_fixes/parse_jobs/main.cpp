@@ -0,0 +1,13 @@
+#include <cassert>
+#include <vector>
+
+int twice(int x);
+int add(int x, int y);
+
+int main()
+{
+  std::vector<int> v;
+  v.push_back(twice(21));
+  assert(add(v[0], 1) == 43);
+  return 0;
+}
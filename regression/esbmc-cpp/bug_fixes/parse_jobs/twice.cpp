@@ -0,0 +1,9 @@
+#include <vector>
+
+int add(int x, int y);
+
+int twice(int x)
+{
+  std::vector<int> v(2, x);
+  return add(v[0], v[1]);
+}
@@ -0,0 +1,9 @@
+int nondet_int();
+
+int main()
+{
+  int x = nondet_int();
+  __ESBMC_assume(x > 0 && x < 100);
+  assert(x * x != 50);
+  return 0;
+}
@@ -0,0 +1,3 @@
+#!/bin/sh
+# A solver which quits after its first answer, like a crashed one
+awk '{ print; fflush() } /^\(check-sat/ { exit }' | z3 -in
@@ -0,0 +1,15 @@
+int nondet_int();
+
+int main()
+{
+  int x = nondet_int(), n = 0;
+  __ESBMC_assume(x >= 0 && x < 10);
+  while(n < 3)
+  {
+    // Each step declares these symbols again in the same solver
+    x = x + 1;
+    ++n;
+  }
+  assert(x >= 3 && x < 13);
+  return 0;
+}
@@ -0,0 +1,13 @@
+#include <assert.h>
+
+int nondet_int();
+
+int main()
+{
+  int x = nondet_int();
+  __ESBMC_assume(x == 5);
+  assert(x != -5);
+  // Same formula as the claim above, found in the cache
+  assert(x != -5);
+  return 0;
+}
@@ -0,0 +1,14 @@
+#include <assert.h>
+
+int nondet_int();
+
+int main()
+{
+  int x = nondet_int();
+  __ESBMC_assume(x >= 0 && x < 10);
+  int y = x * 2;
+  assert(y >= 0);
+  assert(y != 14);
+  assert(y % 2 == 0);
+  return 0;
+}
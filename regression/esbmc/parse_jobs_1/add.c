@@ -0,0 +1,4 @@
+int add(int x, int y)
+{
+  return x + y;
+}
@@ -0,0 +1,11 @@
+#include <assert.h>
+
+int twice(int x);
+int add(int x, int y);
+
+int main()
+{
+  int x = twice(21);
+  assert(add(x, 1) == 43);
+  return 0;
+}
@@ -0,0 +1,6 @@
+int add(int x, int y);
+
+int twice(int x)
+{
+  return add(x, x);
+}
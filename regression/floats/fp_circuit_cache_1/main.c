@@ -0,0 +1,17 @@
+#include <assert.h>
+
+int main()
+{
+  float x, y;
+  __ESBMC_assume(x >= 1.0f && x <= 2.0f);
+  __ESBMC_assume(y >= 1.0f && y <= 2.0f);
+  unsigned n = 0;
+  while(n < 4)
+  {
+    // The same operation in every step
+    float z = x * y;
+    assert(z >= 1.0f && z <= 4.0f);
+    ++n;
+  }
+  return 0;
+}
@@ -0,0 +1,18 @@
+#include <assert.h>
+
+int main()
+{
+  float x, y;
+  __ESBMC_assume(x >= 1.0f && x <= 2.0f);
+  __ESBMC_assume(y >= 1.0f && y <= 2.0f);
+  unsigned n = 0;
+  while(n < 4)
+  {
+    // Only violated in a later step, whose circuits must not come from
+    // the popped contexts of the previous ones
+    float z = x * y;
+    assert(n < 2 || z < 1.0f);
+    ++n;
+  }
+  return 0;
+}
@@ -0,0 +1,11 @@
+#include <assert.h>
+
+int main()
+{
+  float x, y;
+  __ESBMC_assume(x >= 1.0f && x <= 2.0f);
+  __ESBMC_assume(y >= 1.0f && y <= 2.0f);
+  float z = x + y;
+  assert(z < 4.0f);
+  return 0;
+}
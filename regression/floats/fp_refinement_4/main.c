@@ -0,0 +1,15 @@
+#include <assert.h>
+
+int main()
+{
+  float x, y, w = 0.0f;
+  __ESBMC_assume(x >= 1.0f && x <= 2.0f);
+  __ESBMC_assume(y >= 1.0f && y <= 2.0f);
+  // The guard is checked in a pushed solver context, which refines the
+  // product. That must not hide it from the refinement of the final check.
+  float z = x * y;
+  if(z > 0.5f)
+    w = z;
+  assert(z >= 1.0f);
+  return 0;
+}
@@ -0,0 +1,18 @@
+int nondet_int();
+
+int main()
+{
+  int a = 1, b = 2, c = 3, temp;
+  int n = nondet_int();
+
+  // Only 3-inductive: each step reuses its solver for k = 1, 2 and 3
+  for(int i = 0; i < n; i++)
+  {
+    assert(a != b);
+    temp = a;
+    a = b;
+    b = c;
+    c = temp;
+  }
+  return 0;
+}
@@ -0,0 +1,12 @@
+int main()
+{
+  unsigned int x = 0;
+
+  // The base case only fails once the loop is unwound 4 times
+  while(1)
+  {
+    assert(x < 3);
+    x++;
+  }
+  return 0;
+}
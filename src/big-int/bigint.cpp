@@ -28,6 +28,18 @@ static const int single_bits = sizeof(onedig_t) * CHAR_BIT;
 static const twodig_t base = twodig_t(1) << single_bits;
 static const twodig_t single_max = base - 1;
 
+// Shift by single_bits in two steps, which is also defined when a digit
+// is as wide as ullong_t.
+inline ullong_t shift_down(ullong_t ul)
+{
+  return ul >> (single_bits / 2) >> (single_bits / 2);
+}
+
+inline ullong_t shift_up(ullong_t ul)
+{
+  return ul << (single_bits / 2) << (single_bits / 2);
+}
+
 inline unsigned adjust_size(unsigned size)
 {
   // Always allocate at least something greater than an ullong_t.
@@ -49,6 +61,25 @@ inline unsigned adjust_size(unsigned size)
   return size;
 }
 
+// Load at most two digits into a twodig_t.
+inline twodig_t digit_get2(onedig_t const *d, unsigned l)
+{
+  twodig_t t = 0;
+  if(l > 1)
+    t = twodig_t(d[1]) << single_bits;
+  if(l > 0)
+    t |= d[0];
+  return t;
+}
+
+// Store a twodig_t into two digits.
+inline void digit_set2(twodig_t t, onedig_t *d, unsigned &l)
+{
+  d[0] = onedig_t(t);
+  d[1] = onedig_t(t >> single_bits);
+  l = d[1] ? 2 : d[0] ? 1 : 0;
+}
+
 // Compare unsigned digit strings, returns -1/0/+1.
 inline int digit_cmp(onedig_t const *a, onedig_t const *b, unsigned n)
 {
@@ -268,12 +299,14 @@ digit_div(onedig_t *r, const onedig_t *y, unsigned yl, onedig_t *q, unsigned ql)
   }
 }
 
-// Newly allocate uninitialized space for specified number of digits.
-inline void BigInt::allocate(unsigned digits)
+// Free the digits if they are on the heap.
+inline void BigInt::release()
 {
-  size = adjust_size(digits);
-  length = 0;
-  digit = new onedig_t[size];
+  if(size > 0 && digit != local)
+  {
+    memset(digit, 0, size * sizeof digit[0]); // Crypto-paranoia.
+    delete[] digit;
+  }
 }
 
 // Used in assignment: When smaller than specified digits, allocate
@@ -282,10 +315,17 @@ inline void BigInt::reallocate(unsigned digits)
 {
   if(digits > size)
   {
-    if(size)
-      delete[] digit;
-    size = adjust_size(digits);
-    digit = new onedig_t[size];
+    release();
+    if(digits <= inline_digits)
+    {
+      size = inline_digits;
+      digit = local;
+    }
+    else
+    {
+      size = adjust_size(digits);
+      digit = new onedig_t[size];
+    }
   }
 }
 
@@ -294,17 +334,21 @@ inline void BigInt::resize(unsigned digits)
 {
   if(digits > size)
   {
-    onedig_t *old_digit = digit;
-    unsigned old_size = size;
-    size = adjust_size(digits);
-    digit = new onedig_t[size];
-
-    if(old_digit != nullptr)
+    // Inline digits are always big enough, unless this doesn't own its
+    // digits: then they can go inline too.
+    onedig_t *new_digit = local;
+    unsigned new_size = inline_digits;
+    if(digits > inline_digits)
     {
-      memcpy(digit, old_digit, length * sizeof(onedig_t));
-      if(old_size)
-        delete[] old_digit;
+      new_size = adjust_size(digits);
+      new_digit = new onedig_t[new_size];
     }
+
+    if(digit != nullptr)
+      memcpy(new_digit, digit, length * sizeof(onedig_t));
+    release();
+    size = new_size;
+    digit = new_digit;
   }
 }
 
@@ -330,12 +374,12 @@ inline void digit_set(ullong_t ul, onedig_t d[small], unsigned &l)
   if(ul)
   {
     d[l++] = onedig_t(ul);
-    ul >>= single_bits;
+    ul = shift_down(ul);
     if(small > 2)
       while(ul)
       {
         d[l++] = onedig_t(ul);
-        ul >>= single_bits;
+        ul = shift_down(ul);
       }
     else if(ul)
       d[l++] = onedig_t(ul);
@@ -365,11 +409,7 @@ void BigInt::assign(llong_t l)
 
 BigInt::~BigInt()
 {
-  if(size > 0)
-  {
-    memset(digit, 0, size * sizeof digit[0]); // Crypto-paranoia.
-    delete[] digit;
-  }
+  release();
 }
 
 BigInt::BigInt(onedig_t *dig, unsigned len, bool pos)
@@ -378,55 +418,54 @@ BigInt::BigInt(onedig_t *dig, unsigned len, bool pos)
 }
 
 BigInt::BigInt()
-  : size(adjust_size(small)),
-    length(0),
-    digit(new onedig_t[size]),
-    positive(true)
+  : size(inline_digits), length(0), digit(local), positive(true)
 {
 }
 
 BigInt::BigInt(signed long int n)
-  : size(adjust_size(small)), length(0), digit(new onedig_t[size])
+  : size(inline_digits), length(0), digit(local)
 {
   assign(llong_t(n));
 }
 
 BigInt::BigInt(unsigned long int n)
-  : size(adjust_size(small)), length(0), digit(new onedig_t[size])
+  : size(inline_digits), length(0), digit(local)
 {
   assign(ullong_t(n));
 }
 
 BigInt::BigInt(int n)
-  : size(adjust_size(small)), length(0), digit(new onedig_t[size])
+  : size(inline_digits), length(0), digit(local)
 {
   assign(llong_t(n));
 }
 
 BigInt::BigInt(unsigned u)
-  : size(adjust_size(small)), length(0), digit(new onedig_t[size])
+  : size(inline_digits), length(0), digit(local)
 {
   assign(ullong_t(u));
 }
 
 BigInt::BigInt(llong_t l)
-  : size(adjust_size(small)), length(0), digit(new onedig_t[size])
+  : size(inline_digits), length(0), digit(local)
 {
   assign(l);
 }
 
 BigInt::BigInt(ullong_t ul)
-  : size(adjust_size(small)), length(0), digit(new onedig_t[size])
+  : size(inline_digits), length(0), digit(local)
 {
   assign(ul);
 }
 
 BigInt::BigInt(BigInt const &y)
-  : size(adjust_size(y.length)),
-    length(y.length),
-    digit(new onedig_t[size]),
-    positive(y.positive)
+  : size(inline_digits), length(y.length), digit(local), positive(y.positive)
 {
+  if(length > inline_digits)
+  {
+    size = adjust_size(length);
+    digit = new onedig_t[size];
+  }
   memcpy(digit, y.digit, length * sizeof(onedig_t));
 }
 
@@ -436,18 +475,21 @@ BigInt::BigInt(BigInt &&y) : BigInt()
 }
 
 BigInt::BigInt(char const *s, onedig_t b)
-  : size(adjust_size(small)),
-    length(0),
-    digit(new onedig_t[size]),
-    positive(true)
+  : size(inline_digits), length(0), digit(local), positive(true)
 {
   scan(s, b);
 }
 
 BigInt &BigInt::operator=(BigInt const &y)
 {
-  BigInt copy(y);
-  swap(copy);
+  if(this != &y)
+  {
+    // Reuse the digits of this if they are big enough.
+    reallocate(y.length);
+    memcpy(digit, y.digit, y.length * sizeof(onedig_t));
+    length = y.length;
+    positive = y.positive;
+  }
   return *this;
 }
 
@@ -532,19 +574,35 @@ char *BigInt::as_string(char *p, unsigned l, onedig_t b) const
     p[--l] = '0';
     return p + l;
   }
-  // Make a temporary copy of the digits.
-  onedig_t *dig = (onedig_t *)alloca(len * sizeof(onedig_t));
-  memcpy(dig, digit, len * sizeof(onedig_t));
-  // Divide down by single, generating digits from right to left.
-  do
+  if(len <= small)
   {
-    if(l == 0)
-      return nullptr;
-    onedig_t r = digit_div(dig, len, b);
-    p[--l] = r < 10 ? r + '0' : 'A' + r - 10;
-    if(dig[len - 1] == 0)
-      --len;
-  } while(len);
+    // Can do it directly.
+    ullong_t ul = to_uint64();
+    do
+    {
+      if(l == 0)
+        return nullptr;
+      onedig_t r = onedig_t(ul % b);
+      p[--l] = r < 10 ? r + '0' : 'A' + r - 10;
+      ul /= b;
+    } while(ul);
+  }
+  else
+  {
+    // Make a temporary copy of the digits.
+    onedig_t *dig = (onedig_t *)alloca(len * sizeof(onedig_t));
+    memcpy(dig, digit, len * sizeof(onedig_t));
+    // Divide down by single, generating digits from right to left.
+    do
+    {
+      if(l == 0)
+        return nullptr;
+      onedig_t r = digit_div(dig, len, b);
+      p[--l] = r < 10 ? r + '0' : 'A' + r - 10;
+      if(dig[len - 1] == 0)
+        --len;
+    } while(len);
+  }
   // Maybe attach sign.
   if(!positive)
   {
@@ -620,7 +678,7 @@ void BigInt::load(unsigned char const *p, unsigned n)
   {
     if(q <= p)
       break;
-    d |= *--q << i++ * CHAR_BIT;
+    d |= onedig_t(*--q) << i++ * CHAR_BIT;
     if(i < sizeof(onedig_t))
       continue;
     digit[length++] = d;
@@ -660,7 +718,7 @@ uint64_t BigInt::to_uint64() const
   uint64_t ul = 0;
   for(int i = length; --i >= 0;)
   {
-    ul <<= single_bits;
+    ul = shift_up(ul);
     ul |= digit[i];
   }
   return ul;
@@ -723,8 +781,9 @@ int BigInt::compare(BigInt const &b) const
 // Auxiliary method for all adding and subtracting.
 void BigInt::add(onedig_t const *dig, unsigned len, bool pos)
 {
-  // Make sure the result fits into this, even with carry.
-  resize((length > len ? length : len) + 1);
+  // Make sure the result fits into this. A carry is rare, so this only
+  // grows for it when there is one.
+  resize(length > len ? length : len);
 
   // Assign greater operand to d1/l1, for the add/sub primitives
   // expect the greater operand first.
@@ -755,7 +814,10 @@ void BigInt::add(onedig_t const *dig, unsigned len, bool pos)
     onedig_t c = digit_add(d1, l1, d2, l2, digit);
     length = l1;
     if(c)
+    {
+      resize(length + 1);
       digit[length++] = c;
+    }
     // Sign remains unchanged.
   }
   else
@@ -815,9 +877,8 @@ void BigInt::mul(onedig_t const *dig, unsigned len, bool pos)
   else
   {
     // Get a new string of digits for the result.
-    unsigned old_size = size;
-    size = adjust_size(length + len);
-    onedig_t *r = new onedig_t[size];
+    unsigned new_size = adjust_size(length + len);
+    onedig_t *r = new onedig_t[new_size];
 
     // The first parameter pair defines the outer loop which should
     // be the shorter.
@@ -827,8 +888,8 @@ void BigInt::mul(onedig_t const *dig, unsigned len, bool pos)
       digit_mul(dig, len, digit, length, r);
 
     // Replace digit string of this with result.
-    if(old_size)
-      delete[] digit;
+    release();
+    size = new_size;
     digit = r;
     length += len;
     adjust();
@@ -992,10 +1053,20 @@ void BigInt::div(BigInt const &x, BigInt const &y, BigInt &q, BigInt &r)
     q.assign((BigInt::ullong_t)n / m);
     r.assign((BigInt::ullong_t)n % m);
   }
+  else if(x.length <= 2)
+  {
+    // Still fits into twodig_t.
+    twodig_t n = digit_get2(x.digit, x.length);
+    twodig_t m = digit_get2(y.digit, y.length);
+    q.reallocate(2);
+    r.reallocate(2);
+    digit_set2(n / m, q.digit, q.length);
+    digit_set2(n % m, r.digit, r.length);
+  }
   else if(y.length == 1)
   {
     // This digit_div() transforms the dividend into the quotient.
-    q = y;
+    q = x;
     r.digit[0] = digit_div(q.digit, q.length, y.digit[0]);
     r.length = r.digit[0] ? 1 : 0;
   }
@@ -1012,7 +1083,7 @@ void BigInt::div(BigInt const &x, BigInt const &y, BigInt &q, BigInt &r)
     onedig_t *b = (onedig_t *)alloca(bl * sizeof(onedig_t));
     memcpy(b, y.digit, bl * sizeof(onedig_t));
 
-    onedig_t scale = onedig_t(base / (1 + b[bl - 1]));
+    onedig_t scale = onedig_t(base / (twodig_t(1) + b[bl - 1]));
     if(scale != 1)
     {
       if((a[al] = digit_mul(a, al, scale)) != 0)
@@ -1026,8 +1097,8 @@ void BigInt::div(BigInt const &x, BigInt const &y, BigInt &q, BigInt &r)
       a[al++] = 0;
 
     // Prepare q for receiving the quotient.
+    q.resize(al - bl);
     q.length = al - bl;
-    q.resize(q.length);
 
     // Divide.
     digit_div(a, b, bl, q.digit, q.length);
@@ -1039,8 +1110,8 @@ void BigInt::div(BigInt const &x, BigInt const &y, BigInt &q, BigInt &r)
       digit_div(a, al, scale);
     if(al && a[al - 1] == 0)
       --al;
+    r.resize(al);
     r.length = al;
-    r.resize(r.length);
     memcpy(r.digit, a, al * sizeof(onedig_t));
   }
   q.adjust();
@@ -1081,6 +1152,12 @@ BigInt &BigInt::operator/=(BigInt const &y)
       goto zero;
     digit_set(n / m, digit, length);
   }
+  else if(length <= 2)
+  {
+    // Still fits into twodig_t.
+    twodig_t n = digit_get2(digit, length);
+    digit_set2(n / digit_get2(y.digit, y.length), digit, length);
+  }
   else if(y.length == 1)
   {
     // This digit_div() transforms the dividend into the quotient.
@@ -1097,7 +1174,7 @@ BigInt &BigInt::operator/=(BigInt const &y)
     onedig_t *b = (onedig_t *)alloca(bl * sizeof(onedig_t));
     memcpy(b, y.digit, bl * sizeof(onedig_t));
 
-    onedig_t scale = onedig_t(base / (1 + b[bl - 1]));
+    onedig_t scale = onedig_t(base / (twodig_t(1) + b[bl - 1]));
     if(scale != 1)
     {
       if((a[al] = digit_mul(a, al, scale)) != 0)
@@ -1147,6 +1224,12 @@ BigInt &BigInt::operator%=(BigInt const &y)
       goto zero;
     digit_set(n % m, digit, length);
   }
+  else if(length <= 2)
+  {
+    // Still fits into twodig_t.
+    twodig_t n = digit_get2(digit, length);
+    digit_set2(n % digit_get2(y.digit, y.length), digit, length);
+  }
   else if(y.length == 1)
   {
     // This digit_div() transforms the dividend into the quotient.
@@ -1156,17 +1239,18 @@ BigInt &BigInt::operator%=(BigInt const &y)
   }
   else
   {
-    // Scale as above. But do not copy dividend. It is transformed
-    // into the remainder which is the result we want here.
-    resize(length + 2);
-    unsigned &al = length;
-    onedig_t *a = digit;
+    // Copy and scale as above. The copy of the dividend is transformed
+    // into the remainder which is the result we want here. Copying it
+    // on the stack saves growing this beyond its inline digits.
+    unsigned al = length;
+    onedig_t *a = (onedig_t *)alloca((al + 2) * sizeof(onedig_t));
+    memcpy(a, digit, al * sizeof(onedig_t));
 
     unsigned bl = y.length;
     onedig_t *b = (onedig_t *)alloca(bl * sizeof(onedig_t));
     memcpy(b, y.digit, bl * sizeof(onedig_t));
 
-    onedig_t scale = onedig_t(base / (1 + b[bl - 1]));
+    onedig_t scale = onedig_t(base / (twodig_t(1) + b[bl - 1]));
     if(scale != 1)
     {
       if((a[al] = digit_mul(a, al, scale)) != 0)
@@ -1176,6 +1260,7 @@ BigInt &BigInt::operator%=(BigInt const &y)
     if(a[al - 1] >= b[bl - 1])
       a[al++] = 0;
     digit_div(a, b, bl, nullptr, al - bl);
+    memcpy(digit, a, bl * sizeof(onedig_t));
     length = bl;
     adjust();
     if(scale != 1)
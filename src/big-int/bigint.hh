@@ -63,7 +63,11 @@ public:
   // Choose digit type for best performance. Bigger is better as long
   // as there are machine instructions for multiplying and dividing on
   // twice the size of a digit, i.e. on twodig_t.
-#if defined __GNUG__ || defined __alpha // || defined __TenDRA__
+#if defined __SIZEOF_INT128__
+  // 64 bit CPUs, where gcc and clang provide a 128 bit type.
+  typedef uint64_t onedig_t;
+  __extension__ typedef unsigned __int128 twodig_t;
+#elif defined __GNUG__ || defined __alpha // || defined __TenDRA__
   // Or other true 64 bit CPU.
   typedef unsigned onedig_t;
   typedef unsigned long long twodig_t;
@@ -95,20 +99,23 @@ public:
 #endif
 
   // Maximum number of onedig_t digits which could also be represented
-  // by an elementary type.
+  // by an elementary type. Twice as many, i.e. 128 bits, are stored in
+  // the object itself: only greater numbers allocate digits on the heap.
   enum
   {
-    small = sizeof(ullong_t) / sizeof(onedig_t)
+    small = sizeof(ullong_t) / sizeof(onedig_t),
+    inline_digits = 2 * small
   };
 
 private:
-  unsigned size;   // Length of digit vector.
+  unsigned size;   // Length of digit vector, 0 if not owned.
   unsigned length; // Used places in digit vector.
-  onedig_t *digit; // Least significant first.
+  onedig_t *digit; // Least significant first, points to local if inline.
   bool positive;   // Signed magnitude representation.
+  onedig_t local[inline_digits];
 
   // Create or resize this.
-  inline void allocate(unsigned digits);
+  inline void release();
   inline void reallocate(unsigned digits);
   inline void resize(unsigned digits);
 
@@ -312,10 +319,16 @@ public:
 
   void swap(BigInt &other)
   {
+    // Inline digits have to be exchanged too, and pointers to them fixed.
+    std::swap(other.local, local);
     std::swap(other.size, size);
     std::swap(other.length, length);
     std::swap(other.digit, digit);
     std::swap(other.positive, positive);
+    if(digit == other.local)
+      digit = local;
+    if(other.digit == local)
+      other.digit = other.local;
   }
 };
 
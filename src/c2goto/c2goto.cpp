@@ -56,8 +56,6 @@ public:
 
   int doit() override
   {
-    goto_functionst goto_functions;
-
     if(config.set(cmdline))
       return 1;
     config.options.cmdline(cmdline);
@@ -77,7 +75,8 @@ public:
     std::ofstream out(
       cmdline.getval("output"), std::ios::out | std::ios::binary);
 
-    if(write_goto_binary(out, context, goto_functions))
+    // The library is indexed so that esbmc only loads the symbols it needs
+    if(write_goto_binary_indexed(out, context))
     {
       log_error("Failed to write C library to binary obj");
       return 1;
@@ -7,6 +7,8 @@
 #include <util/c_link.h>
 #include <util/config.h>
 #include <util/language.h>
+#include <unordered_map>
+#include <unordered_set>
 
 extern "C"
 {
@@ -116,15 +118,78 @@ static void ingest_symbol(
   deps.erase(name);
 }
 
+/* Pulls the library symbols the program declares but doesn't define into
+ * store_ctx, along with everything they depend on. `lookup` fetches a symbol
+ * of the library by name, or returns nullptr if there's no such symbol. */
+template <class Lookup>
+static void pull_library_symbols(
+  const contextt &context,
+  const std::vector<irep_idt> &library_symbols,
+  Lookup lookup,
+  contextt &store_ctx)
+{
+  std::multimap<irep_idt, irep_idt> symbol_deps;
+  std::list<irep_idt> to_include;
+  std::unordered_set<irep_idt, irep_id_hash> scanned;
+
+  // Dependencies are only computed for the symbols actually reached, instead
+  // of the whole library
+  auto add = [&](const symbolt &s) {
+    if(scanned.insert(s.id).second)
+    {
+      generate_symbol_deps(s.id, s.value, symbol_deps);
+      generate_symbol_deps(s.id, s.type, symbol_deps);
+    }
+    store_ctx.add(s);
+    ingest_symbol(s.id, symbol_deps, to_include);
+  };
+
+  // Add two hacks; we might use either pthread_mutex_lock or the checked
+  // variant; so if one version is used, pull in the other too.
+  std::pair<irep_idt, irep_idt> lockcheck(
+    dstring("pthread_mutex_lock"), dstring("pthread_mutex_lock_check"));
+  symbol_deps.insert(lockcheck);
+
+  std::pair<irep_idt, irep_idt> condcheck(
+    dstring("pthread_cond_wait"), dstring("pthread_cond_wait_check"));
+  symbol_deps.insert(condcheck);
+
+  std::pair<irep_idt, irep_idt> joincheck(
+    dstring("pthread_join"), dstring("pthread_join_noswitch"));
+  symbol_deps.insert(joincheck);
+
+  /* The code just pulled into store_ctx might use other symbols in the C
+   * library. So, repeatedly search for new C library symbols that we use but
+   * haven't pulled in, then pull them in. We finish when we've made a pass
+   * that adds no new symbols. */
+
+  for(const irep_idt &id : library_symbols)
+  {
+    const symbolt *symbol = context.find_symbol(id);
+    if(symbol != nullptr && symbol->value.is_nil())
+    {
+      const symbolt *s = lookup(id);
+      assert(s);
+      add(*s);
+    }
+  }
+
+  for(std::list<irep_idt>::const_iterator nameit = to_include.begin();
+      nameit != to_include.end();
+      nameit++)
+  {
+    const symbolt *s = lookup(*nameit);
+    if(s != nullptr)
+      add(*s);
+  }
+}
+
 void add_cprover_library(contextt &context, const languaget *c_language)
 {
   if(config.ansi_c.lib == configt::ansi_ct::libt::LIB_NONE)
     return;
 
-  contextt new_ctx, store_ctx;
-  goto_functionst goto_functions;
-  std::multimap<irep_idt, irep_idt> symbol_deps;
-  std::list<irep_idt> to_include;
+  contextt store_ctx;
   const buffer *clib;
 
   switch(config.ansi_c.word_size)
@@ -153,53 +218,38 @@ void add_cprover_library(contextt &context, const languaget *c_language)
     abort();
   }
 
-  if(read_goto_binary_array(clib->start, clib->size, new_ctx, goto_functions))
-    abort();
-
-  new_ctx.foreach_operand([&symbol_deps](const symbolt &s) {
-    generate_symbol_deps(s.id, s.value, symbol_deps);
-    generate_symbol_deps(s.id, s.type, symbol_deps);
-  });
-
-  // Add two hacks; we might use either pthread_mutex_lock or the checked
-  // variant; so if one version is used, pull in the other too.
-  std::pair<irep_idt, irep_idt> lockcheck(
-    dstring("pthread_mutex_lock"), dstring("pthread_mutex_lock_check"));
-  symbol_deps.insert(lockcheck);
-
-  std::pair<irep_idt, irep_idt> condcheck(
-    dstring("pthread_cond_wait"), dstring("pthread_cond_wait_check"));
-  symbol_deps.insert(condcheck);
-
-  std::pair<irep_idt, irep_idt> joincheck(
-    dstring("pthread_join"), dstring("pthread_join_noswitch"));
-  symbol_deps.insert(joincheck);
-
-  /* The code just pulled into store_ctx might use other symbols in the C
-   * library. So, repeatedly search for new C library symbols that we use but
-   * haven't pulled in, then pull them in. We finish when we've made a pass
-   * that adds no new symbols. */
+  indexed_goto_binaryt index;
+  if(!index.open(clib->start, clib->size))
+  {
+    // Only deserialize the symbols that are actually used
+    std::unordered_map<irep_idt, symbolt, irep_id_hash> loaded;
+    auto lookup = [&index, &loaded](const irep_idt &id) -> const symbolt * {
+      auto it = loaded.find(id);
+      if(it != loaded.end())
+        return &it->second;
+      symbolt s;
+      if(index.read_symbol(id, s))
+        return nullptr;
+      return &loaded.emplace(id, std::move(s)).first->second;
+    };
+    pull_library_symbols(context, index.symbols(), lookup, store_ctx);
+  }
+  else
+  {
+    // Plain goto binary, load it as a whole
+    contextt new_ctx;
+    goto_functionst goto_functions;
+    if(read_goto_binary_array(clib->start, clib->size, new_ctx, goto_functions))
+      abort();
 
-  new_ctx.foreach_operand(
-    [&context, &store_ctx, &symbol_deps, &to_include](const symbolt &s) {
-      const symbolt *symbol = context.find_symbol(s.id);
-      if(symbol != nullptr && symbol->value.is_nil())
-      {
-        store_ctx.add(s);
-        ingest_symbol(s.id, symbol_deps, to_include);
-      }
+    std::vector<irep_idt> library_symbols;
+    new_ctx.foreach_operand([&library_symbols](const symbolt &s) {
+      library_symbols.push_back(s.id);
     });
-
-  for(std::list<irep_idt>::const_iterator nameit = to_include.begin();
-      nameit != to_include.end();
-      nameit++)
-  {
-    symbolt *s = new_ctx.find_symbol(*nameit);
-    if(s != nullptr)
-    {
-      store_ctx.add(*s);
-      ingest_symbol(*nameit, symbol_deps, to_include);
-    }
+    auto lookup = [&new_ctx](const irep_idt &id) -> const symbolt * {
+      return new_ctx.find_symbol(id);
+    };
+    pull_library_symbols(context, library_symbols, lookup, store_ctx);
   }
 
   if(c_link(context, store_ctx, "<built-in-library>"))
@@ -71,7 +71,7 @@ __ESBMC_HIDE:;
   return start;
 }
 
-size_t strlen(const char *s)
+size_t __strlen_impl(const char *s)
 {
 __ESBMC_HIDE:;
   size_t len = 0;
@@ -80,6 +80,14 @@ __ESBMC_HIDE:;
   return len;
 }
 
+size_t strlen(const char *s)
+{
+__ESBMC_HIDE:;
+  void *hax = &__strlen_impl;
+  (void)hax;
+  return __ESBMC_strlen(s);
+}
+
 int strcmp(const char *p1, const char *p2)
 {
 __ESBMC_HIDE:;
@@ -255,7 +263,7 @@ __ESBMC_HIDE:;
   return cpy;
 }
 
-void *memcpy(void *dst, const void *src, size_t n)
+void *__memcpy_impl(void *dst, const void *src, size_t n)
 {
 __ESBMC_HIDE:;
   char *cdst = dst;
@@ -265,6 +273,14 @@ __ESBMC_HIDE:;
   return dst;
 }
 
+void *memcpy(void *dst, const void *src, size_t n)
+{
+__ESBMC_HIDE:;
+  void *hax = &__memcpy_impl;
+  (void)hax;
+  return __ESBMC_memcpy(dst, src, n);
+}
+
 void *__memset_impl(void *s, int c, size_t n)
 {
 __ESBMC_HIDE:;
@@ -282,7 +298,7 @@ __ESBMC_HIDE:;
   return __ESBMC_memset(s, c, n);
 }
 
-void *memmove(void *dest, const void *src, size_t n)
+void *__memmove_impl(void *dest, const void *src, size_t n)
 {
 __ESBMC_HIDE:;
   char *cdest = dest;
@@ -300,7 +316,15 @@ __ESBMC_HIDE:;
   return dest;
 }
 
-int memcmp(const void *s1, const void *s2, size_t n)
+void *memmove(void *dest, const void *src, size_t n)
+{
+__ESBMC_HIDE:;
+  void *hax = &__memmove_impl;
+  (void)hax;
+  return __ESBMC_memmove(dest, src, n);
+}
+
+int __memcmp_impl(const void *s1, const void *s2, size_t n)
 {
 __ESBMC_HIDE:;
   int res = 0;
@@ -314,6 +338,14 @@ __ESBMC_HIDE:;
   return res;
 }
 
+int memcmp(const void *s1, const void *s2, size_t n)
+{
+__ESBMC_HIDE:;
+  void *hax = &__memcmp_impl;
+  (void)hax;
+  return __ESBMC_memcmp(s1, s2, n);
+}
+
 void *memchr(const void *buf, int ch, size_t n)
 {
   while(n && (*(unsigned char *)buf != (unsigned char)ch))
@@ -15,11 +15,13 @@ CC_DIAGNOSTIC_IGNORE_LLVM_CHECKS()
 #include <clang/Tooling/Tooling.h>
 #include <llvm/Option/ArgList.h>
 #include <llvm/Support/Host.h>
+#include <llvm/Support/MemoryBuffer.h>
 #include <llvm/Support/Path.h>
 CC_DIAGNOSTIC_POP()
 
 #include <clang-c-frontend/AST/build_ast.h>
 #include <clang-c-frontend/AST/esbmc_action.h>
+#include <iterator>
 
 /// Builds a clang driver initialized for running clang tools.
 static clang::driver::Driver *newDriver(
@@ -48,9 +50,38 @@ static clang::driver::Driver *newDriver(
   return CompilerDriver;
 }
 
-std::unique_ptr<clang::ASTUnit> buildASTs(
-  const std::string &intrinsics,
-  const std::vector<std::string> &compiler_args)
+/// Virtual path of the intrinsics a PCH is made of. They only exist in
+/// memory, as a remapped file, which clang does not check against the disk
+/// when loading the PCH.
+static const char *const intrinsics_path = "/esbmc/esbmc_intrinsics.h";
+
+/// Builds the diagnostics engine for the -W options in \p Argv
+static clang::DiagnosticsEngine *newDiagnostics(
+  const std::vector<const char *> &Argv,
+  clang::DiagnosticOptions &DiagOpts,
+  clang::DiagnosticConsumer &Consumer)
+{
+  unsigned MissingArgIndex, MissingArgCount;
+  llvm::opt::InputArgList ParsedArgs =
+    clang::driver::getDriverOptTable().ParseArgs(
+      llvm::ArrayRef<const char *>(Argv).slice(1),
+      MissingArgIndex,
+      MissingArgCount);
+
+  clang::ParseDiagnosticArgs(DiagOpts, ParsedArgs);
+
+  return new clang::DiagnosticsEngine(
+    llvm::IntrusiveRefCntPtr<clang::DiagnosticIDs>(new clang::DiagnosticIDs()),
+    &DiagOpts,
+    &Consumer,
+    false);
+}
+
+/// Runs the clang driver on \p Argv, which must make a single job, and
+/// returns the frontend invocation of that job
+static std::shared_ptr<clang::CompilerInvocation> newInvocation(
+  const std::vector<const char *> &Argv,
+  clang::DiagnosticsEngine *Diagnostics)
 {
   // Create virtual file system to add clang's headers
   llvm::IntrusiveRefCntPtr<llvm::vfs::OverlayFileSystem> OverlayFileSystem(
@@ -63,33 +94,7 @@ std::unique_ptr<clang::ASTUnit> buildASTs(
   llvm::IntrusiveRefCntPtr<clang::FileManager> Files(
     new clang::FileManager(clang::FileSystemOptions(), OverlayFileSystem));
 
-  // Create everything needed to create a CompilerInvocation,
-  // copied from ToolInvocation::run
-  llvm::IntrusiveRefCntPtr<clang::DiagnosticOptions> DiagOpts =
-    new clang::DiagnosticOptions();
-
-  std::vector<const char *> Argv;
-  for(const std::string &Str : compiler_args)
-    Argv.push_back(Str.c_str());
   const char *const BinaryName = Argv[0];
-
-  unsigned MissingArgIndex, MissingArgCount;
-  llvm::opt::InputArgList ParsedArgs =
-    clang::driver::getDriverOptTable().ParseArgs(
-      llvm::ArrayRef<const char *>(Argv).slice(1),
-      MissingArgIndex,
-      MissingArgCount);
-
-  clang::ParseDiagnosticArgs(*DiagOpts, ParsedArgs);
-
-  clang::TextDiagnosticPrinter DiagnosticPrinter(llvm::errs(), &*DiagOpts);
-
-  clang::DiagnosticsEngine *Diagnostics = new clang::DiagnosticsEngine(
-    llvm::IntrusiveRefCntPtr<clang::DiagnosticIDs>(new clang::DiagnosticIDs()),
-    &*DiagOpts,
-    &DiagnosticPrinter,
-    false);
-
   const std::unique_ptr<clang::driver::Driver> Driver(
     newDriver(Diagnostics, BinaryName, &Files->getVirtualFileSystem()));
 
@@ -114,8 +119,82 @@ std::unique_ptr<clang::ASTUnit> buildASTs(
     llvm::errs() << "\n";
   }
 
+  return Invocation;
+}
+
+bool buildPCH(
+  const std::string &intrinsics,
+  const std::vector<std::string> &compiler_args,
+  const std::string &output)
+{
+  std::vector<const char *> Argv;
+  for(const std::string &Str : compiler_args)
+    Argv.push_back(Str.c_str());
+  Argv.push_back(intrinsics_path);
+
+  llvm::IntrusiveRefCntPtr<clang::DiagnosticOptions> DiagOpts =
+    new clang::DiagnosticOptions();
+  clang::TextDiagnosticPrinter DiagnosticPrinter(llvm::errs(), &*DiagOpts);
+  llvm::IntrusiveRefCntPtr<clang::DiagnosticsEngine> Diagnostics(
+    newDiagnostics(Argv, *DiagOpts, DiagnosticPrinter));
+
+  std::shared_ptr<clang::CompilerInvocation> Invocation =
+    newInvocation(Argv, &*Diagnostics);
+
+  clang::FrontendOptions &FrontendOpts = Invocation->getFrontendOpts();
+  if(FrontendOpts.Inputs.size() != 1)
+    return true;
+
+  // Compile the intrinsics as a header of the language of the input
+  FrontendOpts.Inputs[0] = clang::FrontendInputFile(
+    intrinsics_path, FrontendOpts.Inputs[0].getKind().getHeader());
+  FrontendOpts.OutputFile = output;
+  Invocation->getPreprocessorOpts().addRemappedFile(
+    intrinsics_path, llvm::MemoryBuffer::getMemBufferCopy(intrinsics).release());
+
+  clang::CompilerInstance Compiler(
+    std::make_shared<clang::PCHContainerOperations>());
+  Compiler.setInvocation(std::move(Invocation));
+  Compiler.createDiagnostics(&DiagnosticPrinter, false);
+
+  clang::GeneratePCHAction action;
+  return !Compiler.ExecuteAction(action) ||
+         Compiler.getDiagnostics().hasErrorOccurred();
+}
+
+std::unique_ptr<clang::ASTUnit> buildASTs(
+  const std::string &intrinsics,
+  const std::vector<std::string> &compiler_args,
+  const std::string &pch)
+{
+  // Load the intrinsics from the PCH, included before the input (the last
+  // argument)
+  std::vector<std::string> args(compiler_args);
+  if(!pch.empty())
+  {
+    args.insert(std::prev(args.end()), "-include-pch");
+    args.insert(std::prev(args.end()), pch);
+  }
+
+  // Create everything needed to create a CompilerInvocation,
+  // copied from ToolInvocation::run
+  llvm::IntrusiveRefCntPtr<clang::DiagnosticOptions> DiagOpts =
+    new clang::DiagnosticOptions();
+
+  std::vector<const char *> Argv;
+  for(const std::string &Str : args)
+    Argv.push_back(Str.c_str());
+
+  clang::TextDiagnosticPrinter DiagnosticPrinter(llvm::errs(), &*DiagOpts);
+
+  clang::DiagnosticsEngine *Diagnostics =
+    newDiagnostics(Argv, *DiagOpts, DiagnosticPrinter);
+
+  std::shared_ptr<clang::CompilerInvocation> Invocation =
+    newInvocation(Argv, Diagnostics);
+
   // Create our custom action
-  auto action = new esbmc_action(std::move(intrinsics));
+  auto action = new esbmc_action(pch.empty() ? std::string(intrinsics) : "");
 
   // Create ASTUnit
   std::unique_ptr<clang::ASTUnit> unit(
@@ -2,6 +2,7 @@
 #define CLANG_C_FRONTEND_AST_BUILD_AST_H_
 
 #include <memory>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -14,8 +15,18 @@ namespace clang
 class ASTUnit;
 } // namespace clang
 
+/// Parses the input of \p compiler_args, its last argument, after the
+/// intrinsics. These are loaded from \p pch if it isn't empty.
 std::unique_ptr<clang::ASTUnit> buildASTs(
   const std::string &intrinsics,
-  const std::vector<std::string> &compiler_args);
+  const std::vector<std::string> &compiler_args,
+  const std::string &pch = "");
+
+/// Precompiles \p intrinsics into the PCH \p output, with the options of
+/// \p compiler_args (which has no input). Returns true on error.
+bool buildPCH(
+  const std::string &intrinsics,
+  const std::vector<std::string> &compiler_args,
+  const std::string &output);
 
 #endif /* CLANG_C_FRONTEND_AST_BUILD_AST_H_ */
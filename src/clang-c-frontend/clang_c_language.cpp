@@ -1,6 +1,7 @@
 #include <util/compiler_defs.h>
 CC_DIAGNOSTIC_PUSH()
 CC_DIAGNOSTIC_IGNORE_LLVM_CHECKS()
+#include <clang/Basic/Version.inc>
 #include <clang/Frontend/ASTUnit.h>
 CC_DIAGNOSTIC_POP()
 
@@ -15,6 +16,7 @@ CC_DIAGNOSTIC_POP()
 #include <clang-c-frontend/expr2c.h>
 #include <sstream>
 #include <util/c_link.h>
+#include <util/crypto_hash.h>
 
 #include <util/filesystem.h>
 
@@ -214,8 +216,13 @@ bool clang_c_languaget::parse(const std::string &path)
   if(preprocess(path, o_preprocessed))
     return true;
 
-  // Force the file type, .c for the C frontend and .cpp for the C++ one
-  force_file_type();
+  // Force the file type, .c for the C frontend and .cpp for the C++ one.
+  // The arguments are kept for the next file, so only once.
+  if(!file_type_forced)
+  {
+    force_file_type();
+    file_type_forced = true;
+  }
 
   // Get compiler arguments and add the file path
   std::vector<std::string> new_compiler_args(compiler_args);
@@ -224,8 +231,14 @@ bool clang_c_languaget::parse(const std::string &path)
   // Get intrinsics
   std::string intrinsics = internal_additions();
 
+  // Load them precompiled, if there's a cache for that
+  std::string pch;
+  const std::string pch_dir = config.options.get_option("clang-pch-cache");
+  if(!pch_dir.empty())
+    pch = intrinsics_pch(pch_dir, intrinsics);
+
   // Generate ASTUnit and add to our vector
-  auto AST = buildASTs(intrinsics, new_compiler_args);
+  auto AST = buildASTs(intrinsics, new_compiler_args, pch);
 
   ASTs.push_back(std::move(AST));
 
@@ -237,6 +250,51 @@ bool clang_c_languaget::parse(const std::string &path)
   return false;
 }
 
+std::string clang_c_languaget::intrinsics_pch(
+  const std::string &dir,
+  const std::string &intrinsics) const
+{
+  // A PCH can only be loaded by the same clang with the same options. The
+  // headers directories can be new temporary ones in every run, but the
+  // intrinsics include nothing.
+  crypto_hash key(crypto_hash::enginet::sha1);
+  auto ingest = [&key](const std::string &s) {
+    key.ingest(s.c_str(), s.size() + 1);
+  };
+  ingest(CLANG_VERSION_STRING);
+  ingest(intrinsics);
+  for(const std::string &arg : compiler_args)
+    if(!is_per_run_arg(arg))
+      ingest(arg);
+  key.fin();
+
+  const std::string pch = dir + "/" + key.to_string() + ".pch";
+  if(boost::filesystem::exists(pch))
+    return pch;
+
+  // Build it under a unique name first, concurrent runs must not load a
+  // partial PCH
+  boost::system::error_code ec;
+  boost::filesystem::create_directories(dir, ec);
+  const std::string tmp =
+    pch + boost::filesystem::unique_path(".%%%%-%%%%-%%%%").string();
+  if(!buildPCH(intrinsics, compiler_args, tmp))
+  {
+    boost::filesystem::rename(tmp, pch, ec);
+    if(!ec)
+      return pch;
+  }
+
+  boost::filesystem::remove(tmp, ec);
+  log_warning("Failed to precompile the intrinsics into {}", pch);
+  return "";
+}
+
+bool clang_c_languaget::is_per_run_arg(const std::string &arg) const
+{
+  return arg == clang_headers_path();
+}
+
 bool clang_c_languaget::typecheck(contextt &context, const std::string &module)
 {
   contextt new_context;
@@ -318,6 +376,10 @@ _Bool __ESBMC_is_little_endian();
 int __ESBMC_rounding_mode = 0;
 
 void *__ESBMC_memset(void *, int, unsigned int);
+void *__ESBMC_memcpy(void *, const void *, __SIZE_TYPE__);
+void *__ESBMC_memmove(void *, const void *, __SIZE_TYPE__);
+int __ESBMC_memcmp(const void *, const void *, __SIZE_TYPE__);
+__SIZE_TYPE__ __ESBMC_strlen(const char *);
 
 void __ESBMC_memory_leak_checks();
 
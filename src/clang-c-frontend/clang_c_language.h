@@ -19,6 +19,12 @@ public:
 
   bool parse(const std::string &path) override;
 
+  // Parsing only runs clang, on an ASTUnit of its own
+  bool parse_is_thread_safe() const override
+  {
+    return true;
+  }
+
   bool final(contextt &context) override;
 
   bool typecheck(contextt &context, const std::string &module) override;
@@ -51,10 +57,20 @@ protected:
   virtual std::string internal_additions();
   virtual void force_file_type();
 
+  /// Path of the PCH of \p intrinsics for the current options in \p dir,
+  /// which is built if missing. Empty if building it fails.
+  std::string
+  intrinsics_pch(const std::string &dir, const std::string &intrinsics) const;
+
+  /// Whether the compiler argument \p arg names a directory made anew in
+  /// every run, which the PCH cache key has to leave out
+  virtual bool is_per_run_arg(const std::string &arg) const;
+
   static const std::string &clang_headers_path();
   void build_compiler_args(const std::string &tmp_dir);
 
   std::vector<std::string> compiler_args;
+  bool file_type_forced = false;
   std::vector<std::unique_ptr<clang::ASTUnit>> ASTs;
 };
 
@@ -1,5 +1,6 @@
 #include <clang-c-frontend/clang_c_language.h>
 #include <fstream>
+#include <mutex>
 #include <ac_config.h>
 #include <util/filesystem.h>
 
@@ -15,21 +16,21 @@ const std::string &clang_c_languaget::clang_headers_path()
 {
 #ifdef ESBMC_CLANG_HEADERS_BUNDLED
   // Dump clang headers into a temporary directory
-  static bool dumped = false;
+  static std::once_flag dumped;
   /* About the path being static:
-   * The static member 'dumped' above is used to check whether the headers were
+   * The flag 'dumped' above is used to check whether the headers were
    * ever extracted before. This guarantees that the same path is used
-   * during a run. And no more than one is required anyway */
+   * during a run. And no more than one is required anyway.
+   * With --parse-jobs, files are parsed concurrently: call_once makes the
+   * other threads wait until all headers are written. */
   static auto p =
     file_operations::create_tmp_dir("esbmc-headers-%%%%-%%%%-%%%%");
-  if(!dumped)
-  {
-    dumped = true;
+  std::call_once(dumped, []() {
 #define ESBMC_FLAIL(body, size, ...)                                           \
   std::ofstream(p.path() + "/" #__VA_ARGS__).write(body, size);
 #include <headers/cheaders.h>
 #undef ESBMC_FLAIL
-  }
+  });
   return p.path();
 #else
   // clang headers not bundled, return the path set at compile time
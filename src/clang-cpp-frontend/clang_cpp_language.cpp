@@ -15,6 +15,7 @@ CC_DIAGNOSTIC_POP()
 #include <regex>
 #include <util/filesystem.h>
 #include <fstream>
+#include <mutex>
 
 languaget *new_clang_cpp_language()
 {
@@ -48,6 +49,18 @@ void clang_cpp_languaget::force_file_type()
   compiler_args.push_back("c++");
 }
 
+bool clang_cpp_languaget::is_per_run_arg(const std::string &arg) const
+{
+  // The abstracted C++ headers are dumped anew in every run too
+  const std::string isystem = "-isystem";
+  if(
+    arg.size() > isystem.size() && arg.rfind(isystem, 0) == 0 &&
+    arg.substr(isystem.size()) == esbmc_cpp_includes())
+    return true;
+
+  return clang_c_languaget::is_per_run_arg(arg);
+}
+
 std::string clang_cpp_languaget::internal_additions()
 {
   std::string intrinsics = "extern \"C\" {\n";
@@ -112,20 +125,20 @@ extern "C"
 const std::string &clang_cpp_languaget::esbmc_cpp_includes()
 {
   // Dump CPP headers into a temporary directory
-  static bool dumped = false;
+  static std::once_flag dumped;
   /* About the path being static:
-   * The static member 'dumped' above is used to check whether the headers were
+   * The flag 'dumped' above is used to check whether the headers were
    * ever extracted before. This guarantees that the same path is used
-   * during a run. And no more than one is required anyway */
+   * during a run. And no more than one is required anyway.
+   * With --parse-jobs, files are parsed concurrently: call_once makes the
+   * other threads wait until all headers are written. */
   static auto p =
     file_operations::create_tmp_dir("esbmc-cpp-headers-%%%%-%%%%-%%%%");
-  if(!dumped)
-  {
-    dumped = true;
+  std::call_once(dumped, []() {
 #define ESBMC_FLAIL(body, size, ...)                                           \
   std::ofstream(p.path() + "/" #__VA_ARGS__).write(body, size);
 #include <abstract_includes/cpp_includes.h> /* generated by build system */
 #undef ESBMC_FLAIL
-  }
+  });
   return p.path();
 }
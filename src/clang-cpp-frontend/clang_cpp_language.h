@@ -34,6 +34,7 @@ public:
 protected:
   std::string internal_additions() override;
   void force_file_type() override;
+  bool is_per_run_arg(const std::string &arg) const override;
   std::list<std::string> standards{"98", "03", "11", "14", "17"};
   static const std::string &esbmc_cpp_includes();
 };
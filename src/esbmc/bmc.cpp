@@ -8,6 +8,7 @@
 #ifndef _WIN32
 #include <unistd.h>
 #include <sched.h>
+#include <sys/wait.h>
 #else
 #include <windows.h>
 #include <winbase.h>
@@ -38,9 +39,47 @@
 #include <util/show_symbol_table.h>
 #include <util/time_stopping.h>
 #include <util/cache.h>
+#include <util/thread_pool.h>
 #include <atomic>
+#include <set>
 #include <goto-symex/witnesses.h>
 
+/// Salt of the digests of --cache-asserts-file: the version and every option
+/// that may change how an unchanged formula is encoded or what it means (the
+/// solver, the integer and floating-point encodings, the checks...). Only
+/// options known to affect nothing but the output or the resources are left
+/// out, as an option missing here would make the cache unsound.
+static std::string cache_salt(const optionst &options)
+{
+  static const std::set<std::string> irrelevant = {
+    "cache-asserts-file",
+    "color",
+    "compact-trace",
+    "enable-core-dump",
+    "file-output",
+    "input-file",
+    "interval-analysis-jobs",
+    "memlimit",
+    "output",
+    "parse-jobs",
+    "quiet",
+    "result-only",
+    "show-cex",
+    "ssa-trace",
+    "symex-trace",
+    "timeout",
+    "verbosity",
+    "witness-output",
+    "witness-producer",
+    "witness-programfile"};
+
+  std::string salt = ESBMC_VERSION;
+  for(const auto &[opt, value] : options.option_map)
+    if(!irrelevant.count(opt))
+      salt += fmt::format(";{}={}", opt, value);
+  return salt;
+}
+
 bmct::bmct(goto_functionst &funcs, optionst &opts, contextt &_context)
   : options(opts), context(_context), ns(context)
 {
@@ -61,6 +100,25 @@ bmct::bmct(goto_functionst &funcs, optionst &opts, contextt &_context)
         config.ssa_caching_db, !options.get_bool_option("forward-condition")));
   }
 
+  const std::string cache_file = options.get_option("cache-asserts-file");
+  if(!cache_file.empty())
+  {
+    proven_cache = std::make_shared<persistent_assert_cache>(
+      cache_file, cache_salt(options));
+  }
+
+  if(!options.get_option("portfolio").empty())
+  {
+    // These solve with a single solver of their own
+    for(const char *opt :
+        {"multi-property",
+         "smt-during-symex",
+         "smt-formula-only",
+         "smt-formula-too"})
+      if(options.get_bool_option(opt))
+        log_warning("--portfolio is ignored with --{}", opt);
+  }
+
   if(options.get_bool_option("smt-during-symex"))
   {
     runtime_solver = std::shared_ptr<smt_convt>(create_solver("", ns, options));
@@ -84,6 +142,76 @@ bmct::bmct(goto_functionst &funcs, optionst &opts, contextt &_context)
   }
 }
 
+incremental_bmc_solvert::incremental_bmc_solvert(
+  const contextt &context,
+  const optionst &opts)
+  : ns(context), options(opts)
+{
+}
+
+static bool same_step(
+  const symex_target_equationt::SSA_stept &a,
+  const symex_target_equationt::SSA_stept &b)
+{
+  return a.type == b.type && a.ignore == b.ignore && a.guard == b.guard &&
+         a.cond == b.cond && a.lhs == b.lhs && a.rhs == b.rhs &&
+         a.output_args == b.output_args;
+}
+
+std::shared_ptr<smt_convt> &incremental_bmc_solvert::prepare(
+  const std::shared_ptr<symex_target_equationt> &eq)
+{
+  if(pushed)
+  {
+    solver->pop_ctx();
+    pushed = false;
+  }
+
+  // Length of the prefix shared with the previous equation
+  size_t shared = 0;
+  auto it = eq->SSA_steps.begin();
+  if(last_eq)
+  {
+    for(auto last_it = last_eq->SSA_steps.begin();
+        it != eq->SSA_steps.end() && last_it != last_eq->SSA_steps.end() &&
+        same_step(*it, *last_it);
+        ++it, ++last_it)
+      shared++;
+  }
+
+  // The base context defines symbols the new equation defines differently,
+  // start over
+  if(!solver || shared < stable)
+  {
+    if(solver)
+      log_debug("Equation diverged from the previous bound, new solver");
+    solver = std::shared_ptr<smt_convt>(create_solver("", ns, options));
+    stable = 0;
+  }
+
+  // Assert the definitions of the steps shared by the last two equations at
+  // the base level: they are likely to be shared with the next one as well.
+  // Assertions and assumptions are left out, they are only meaningful
+  // together with the whole equation.
+  smt_astt assumpt_ast = solver->convert_ast(gen_true_expr());
+  smt_convt::ast_vec assertions;
+  it = eq->SSA_steps.begin();
+  std::advance(it, stable);
+  for(; stable < shared; ++stable, ++it)
+    if(it->is_assignment() || it->is_renumber())
+      eq->convert_internal_step(*solver, assumpt_ast, assertions, *it);
+
+  log_debug(
+    "Reusing {} of {} step(s) encoded for the previous bound",
+    stable,
+    eq->SSA_steps.size());
+
+  solver->push_ctx();
+  pushed = true;
+  last_eq = eq;
+  return solver;
+}
+
 void bmct::do_cbmc(
   std::shared_ptr<smt_convt> &smt_conv,
   std::shared_ptr<symex_target_equationt> &eq)
@@ -189,7 +317,7 @@ smt_convt::resultt bmct::run_decision_procedure(
   log_progress("Solving with solver {}", smt_conv->solver_text());
 
   fine_timet sat_start = current_time();
-  smt_convt::resultt dec_result = smt_conv->dec_solve();
+  smt_convt::resultt dec_result = smt_conv->dec_solve_refined();
   fine_timet sat_stop = current_time();
 
   // output runtime
@@ -292,6 +420,11 @@ void bmct::report_trace(
     break;
 
   case smt_convt::P_SATISFIABLE:
+    // Without equation, the interleaving worker or the portfolio racer
+    // which found the counterexample has reported it already
+    if(!eq)
+      break;
+
     if(!bs && show_cex)
     {
       error_trace(runtime_solver, eq);
@@ -410,6 +543,18 @@ smt_convt::resultt bmct::run(std::shared_ptr<symex_target_equationt> &eq)
   if(options.get_bool_option("schedule"))
     return run_thread(eq);
 
+  // Validated when the options were read
+  unsigned workers =
+    strtoul(options.get_option("parallel-interleavings").c_str(), nullptr, 10);
+  if(workers > 1 && !options.get_bool_option("interactive-ileaves"))
+    return run_interleaving_workers(workers);
+
+  return run_interleavings(eq);
+}
+
+smt_convt::resultt
+bmct::run_interleavings(std::shared_ptr<symex_target_equationt> &eq)
+{
   smt_convt::resultt res;
   do
   {
@@ -419,7 +564,15 @@ smt_convt::resultt bmct::run(std::shared_ptr<symex_target_equationt> &eq)
     fine_timet bmc_start = current_time();
     res = run_thread(eq);
 
-    if(res == smt_convt::P_SATISFIABLE)
+    // Subtrees of other workers are neither solved nor counted
+    if(!symex->owns_current_formula())
+    {
+      --interleaving_number;
+      continue;
+    }
+
+    // Without equation, the counterexample was dealt with in another process
+    if(res == smt_convt::P_SATISFIABLE && eq)
     {
       if(config.options.get_bool_option("smt-model"))
         runtime_solver->print_model();
@@ -449,6 +602,293 @@ smt_convt::resultt bmct::run(std::shared_ptr<symex_target_equationt> &eq)
   return interleaving_failed > 0 ? smt_convt::P_SATISFIABLE : res;
 }
 
+smt_convt::resultt bmct::run_interleaving_workers(unsigned workers)
+{
+#ifdef _WIN32
+  log_warning("Windows does not support parallel interleavings");
+  std::shared_ptr<symex_target_equationt> eq;
+  return run_interleavings(eq);
+#else
+  struct worker_resultt
+  {
+    unsigned worker;
+    smt_convt::resultt res;
+    uint64_t interleavings;
+    uint64_t failed;
+    unsigned own_subtrees;
+    unsigned subtrees;
+  };
+
+  int result_pipe[2];
+  if(pipe(result_pipe))
+  {
+    log_error("Pipe creation failed");
+    return smt_convt::P_ERROR;
+  }
+
+  // Validated when the options were read
+  unsigned depth = strtoul(
+    options.get_option("interleaving-split-depth").c_str(), nullptr, 10);
+  std::vector<pid_t> children_pid;
+
+  // Don't let the children print what's still buffered
+  fflush(nullptr);
+
+  for(unsigned w = 0; w < workers; w++)
+  {
+    pid_t pid = fork();
+    if(pid == -1)
+    {
+      log_error("Fork failed");
+      for(pid_t child : children_pid)
+        kill(child, SIGKILL);
+      return smt_convt::P_ERROR;
+    }
+
+    if(!pid)
+    {
+      close(result_pipe[0]);
+      symex->partition_interleavings(w, workers, depth);
+
+      std::shared_ptr<symex_target_equationt> eq;
+      worker_resultt r;
+      r.worker = w;
+      r.res = run_interleavings(eq);
+      r.interleavings = interleaving_number.to_uint64();
+      r.failed = interleaving_failed.to_uint64();
+      r.own_subtrees = symex->own_subtrees();
+      r.subtrees = symex->dealt_subtrees();
+
+      // Only this worker has the counterexample
+      if(r.res == smt_convt::P_SATISFIABLE)
+        report_trace(r.res, eq);
+
+      fflush(nullptr);
+      if(write(result_pipe[1], &r, sizeof(r)) != sizeof(r))
+        _exit(1);
+      _exit(0);
+    }
+
+    children_pid.push_back(pid);
+  }
+
+  close(result_pipe[1]);
+
+  log_status(
+    "Exploring interleavings with {} workers, split at depth {}",
+    workers,
+    depth);
+
+  smt_convt::resultt res = smt_convt::P_UNSATISFIABLE;
+  unsigned finished = 0;
+  worker_resultt r;
+  while(finished < workers &&
+        read(result_pipe[0], &r, sizeof(r)) == sizeof(r))
+  {
+    ++finished;
+    log_status(
+      "Worker {} explored {} interleaving(s) in {} of {} subtree(s)",
+      r.worker,
+      r.interleavings,
+      r.own_subtrees,
+      r.subtrees);
+    interleaving_number += r.interleavings;
+    interleaving_failed += r.failed;
+
+    if(r.res == smt_convt::P_SATISFIABLE)
+    {
+      res = r.res;
+      // First counterexample found, stop the others
+      if(!options.get_bool_option("all-runs"))
+        break;
+    }
+    else if(res == smt_convt::P_UNSATISFIABLE)
+      res = r.res;
+  }
+  close(result_pipe[0]);
+
+  if(finished < workers && res != smt_convt::P_SATISFIABLE)
+  {
+    log_error("Interleaving worker terminated without a result");
+    res = smt_convt::P_ERROR;
+  }
+
+  for(pid_t child : children_pid)
+  {
+    kill(child, SIGKILL);
+    waitpid(child, nullptr, 0);
+  }
+
+  return res;
+#endif
+}
+
+/// The solvers listed by --portfolio, if any
+static std::vector<std::string> portfolio_solvers(const optionst &options)
+{
+  std::vector<std::string> solvers;
+  std::istringstream list(options.get_option("portfolio"));
+  std::string name;
+  while(std::getline(list, name, ','))
+  {
+    if(name.empty())
+      continue;
+    if(!is_solver_available(name))
+      throw fmt::format(
+        "The {} solver has not been built into this version of ESBMC, sorry",
+        name);
+    solvers.push_back(name);
+  }
+  return solvers;
+}
+
+smt_convt::resultt bmct::run_portfolio(
+  std::shared_ptr<symex_target_equationt> &eq,
+  const std::vector<std::string> &solvers)
+{
+#ifdef _WIN32
+  log_warning("Windows does not support portfolio solving");
+  runtime_solver =
+    std::shared_ptr<smt_convt>(create_solver(solvers.front(), ns, options));
+  return run_decision_procedure(runtime_solver, eq);
+#else
+  struct racer_resultt
+  {
+    unsigned solver;
+    smt_convt::resultt res;
+  };
+
+  int result_pipe[2];
+  if(pipe(result_pipe))
+  {
+    log_error("Pipe creation failed");
+    return smt_convt::P_ERROR;
+  }
+
+  // A satisfiable racer waits for a byte on its own pipe before reporting
+  // its counterexample, so that only the winner does
+  std::vector<pid_t> children_pid;
+  std::vector<int> report_fds;
+  fflush(nullptr);
+
+  for(unsigned i = 0; i < solvers.size(); i++)
+  {
+    int report_pipe[2];
+    pid_t pid = -1;
+    if(!pipe(report_pipe))
+    {
+      pid = fork();
+      if(pid == -1)
+      {
+        close(report_pipe[0]);
+        close(report_pipe[1]);
+      }
+    }
+    if(pid == -1)
+    {
+      log_error("Fork failed");
+      for(pid_t child : children_pid)
+        kill(child, SIGKILL);
+      return smt_convt::P_ERROR;
+    }
+
+    if(!pid)
+    {
+      close(result_pipe[0]);
+      close(report_pipe[1]);
+      for(int fd : report_fds)
+        close(fd);
+
+      racer_resultt r = {i, smt_convt::P_ERROR};
+      try
+      {
+        runtime_solver =
+          std::shared_ptr<smt_convt>(create_solver(solvers[i], ns, options));
+        r.res = run_decision_procedure(runtime_solver, eq);
+      }
+      catch(...)
+      {
+      }
+
+      fflush(nullptr);
+      if(write(result_pipe[1], &r, sizeof(r)) != sizeof(r))
+        _exit(1);
+
+      // The model only exists in this process
+      char go;
+      if(
+        r.res == smt_convt::P_SATISFIABLE &&
+        read(report_pipe[0], &go, 1) == 1)
+      {
+        if(config.options.get_bool_option("smt-model"))
+          runtime_solver->print_model();
+        if(config.options.get_bool_option("bidirectional"))
+          bidirectional_search(runtime_solver, eq);
+        report_trace(r.res, eq);
+        fflush(nullptr);
+      }
+      _exit(0);
+    }
+
+    close(report_pipe[0]);
+    report_fds.push_back(report_pipe[1]);
+    children_pid.push_back(pid);
+  }
+
+  close(result_pipe[1]);
+
+  // Wait for the first definitive answer; errors (e.g. a solver giving up)
+  // leave the race to the others
+  smt_convt::resultt res = smt_convt::P_ERROR;
+  unsigned finished = 0, winner = 0;
+  racer_resultt r;
+  while(finished < solvers.size() &&
+        read(result_pipe[0], &r, sizeof(r)) == sizeof(r))
+  {
+    ++finished;
+    if(
+      r.res == smt_convt::P_SATISFIABLE || r.res == smt_convt::P_UNSATISFIABLE)
+    {
+      res = r.res;
+      winner = r.solver;
+      break;
+    }
+  }
+  close(result_pipe[0]);
+
+  if(res != smt_convt::P_ERROR)
+    log_status("Solver {} answered first", solvers[winner]);
+
+  if(res == smt_convt::P_SATISFIABLE)
+  {
+    // Let the winner report its counterexample before stopping the race
+    fflush(nullptr);
+    const char go = 1;
+    if(write(report_fds[winner], &go, 1) == 1)
+      waitpid(children_pid[winner], nullptr, 0);
+    else
+      log_error("Could not get the counterexample of {}", solvers[winner]);
+
+    // Reported already, see report_trace
+    eq.reset();
+  }
+
+  for(int fd : report_fds)
+    close(fd);
+
+  for(pid_t child : children_pid)
+  {
+    kill(child, SIGKILL);
+    waitpid(child, nullptr, 0);
+  }
+
+  if(res == smt_convt::P_ERROR)
+    log_error("No solver of the portfolio gave an answer");
+
+  return res;
+#endif
+}
+
 void bmct::bidirectional_search(
   std::shared_ptr<smt_convt> &smt_conv,
   std::shared_ptr<symex_target_equationt> &eq)
@@ -615,6 +1055,10 @@ smt_convt::resultt bmct::run_thread(std::shared_ptr<symex_target_equationt> &eq)
 
   fine_timet symex_stop = current_time();
 
+  // This formula is the incomplete prefix of another worker's subtree
+  if(!symex->owns_current_formula())
+    return smt_convt::P_UNSATISFIABLE;
+
   eq = std::dynamic_pointer_cast<symex_target_equationt>(result->target);
 
   log_status(
@@ -675,18 +1119,64 @@ smt_convt::resultt bmct::run_thread(std::shared_ptr<symex_target_equationt> &eq)
       return smt_convt::P_UNSATISFIABLE;
     }
 
-    if(!options.get_bool_option("smt-during-symex"))
-    {
-      runtime_solver =
-        std::shared_ptr<smt_convt>(create_solver("", ns, options));
-    }
-
     if(
       options.get_bool_option("multi-property") &&
       options.get_bool_option("base-case"))
+    {
+      if(!options.get_bool_option("smt-during-symex"))
+        runtime_solver =
+          std::shared_ptr<smt_convt>(create_solver("", ns, options));
+      if(
+        options.get_bool_option("multi-property-incremental") &&
+        !options.get_bool_option("parallel-solving") &&
+        !options.get_bool_option("smt-during-symex"))
+        return multi_property_incremental(eq);
       return multi_property_check(eq, result->remaining_claims);
+    }
+
+    std::string digest;
+    const bool use_cache = proven_cache &&
+                           !options.get_bool_option("smt-during-symex") &&
+                           !options.get_bool_option("smt-formula-only");
+    if(use_cache)
+    {
+      digest = proven_cache->digest(eq->SSA_steps);
+      if(proven_cache->contains(digest))
+      {
+        log_status("All remaining VCC(s) were proven in a previous run");
+        return smt_convt::P_UNSATISFIABLE;
+      }
+    }
+
+    // A dumped formula has to be self-contained
+    const bool dump = options.get_bool_option("smt-formula-only") ||
+                      options.get_bool_option("smt-formula-too");
+    const bool during_symex = options.get_bool_option("smt-during-symex");
+    const std::vector<std::string> portfolio = portfolio_solvers(options);
+
+    smt_convt::resultt res;
+    if(!portfolio.empty() && !dump && !during_symex)
+      res = run_portfolio(eq, portfolio);
+    else
+    {
+      if(!during_symex)
+      {
+        if(incremental_solver && !dump)
+          runtime_solver = incremental_solver->prepare(eq);
+        else
+          runtime_solver =
+            std::shared_ptr<smt_convt>(create_solver("", ns, options));
+      }
 
-    return run_decision_procedure(runtime_solver, eq);
+      res = run_decision_procedure(runtime_solver, eq);
+    }
+
+    if(use_cache && res == smt_convt::P_UNSATISFIABLE)
+    {
+      proven_cache->insert(digest);
+      proven_cache->save();
+    }
+    return res;
   }
 
   catch(std::string &error_str)
@@ -725,7 +1215,6 @@ smt_convt::resultt bmct::multi_property_check(
   // For coverage info
   int tracked_instrument = 0;
 
-  // TODO: This is the place to check a cache
   for(size_t i = 1; i <= remaining_claims; i++)
     jobs.emplace(i);
 
@@ -745,20 +1234,34 @@ smt_convt::resultt bmct::multi_property_check(
   auto job_function =
     [this, &eq, &ce_counter, &final_result, &result_mutex, &tracked_instrument](
       const size_t &i) {
-      // Since this is just a copy, we probably don't need a lock
-      auto local_eq = std::make_shared<symex_target_equationt>(*eq);
-
     // Just to confirm that things are in parallel
 #ifndef _WIN32
 #ifndef __APPLE__ // sched_getcpu not supported in OS X
       log_debug("Thread running on Core {}", sched_getcpu());
 #endif
 #endif
-      // Set up the current claim and slice it!
+      // Set up the current claim and slice it! The shared equation is
+      // only read here: slicing goes into a per-claim ignore mask and only
+      // the steps that survive it are copied into the local equation.
+      symex_target_equationt::ignore_maskt mask = eq->get_ignore_mask();
       claim_slicer claim(i);
-      claim.run(local_eq->SSA_steps);
+      claim.run(eq->SSA_steps, mask);
       symex_slicet slicer(options);
-      slicer.run(local_eq->SSA_steps);
+      slicer.run(eq->SSA_steps, mask);
+      auto local_eq = eq->apply_ignore_mask(mask);
+
+      // Was this claim (with the same cone of influence) proven before?
+      std::string digest;
+      if(proven_cache)
+      {
+        digest = proven_cache->digest(local_eq->SSA_steps);
+        if(proven_cache->contains(digest))
+        {
+          log_status(
+            "Claim '{}' was proven in a previous run", claim.claim_msg);
+          return;
+        }
+      }
 
       // Initialize a solver
       auto runtime_solver =
@@ -775,8 +1278,9 @@ smt_convt::resultt bmct::multi_property_check(
       /* TODO: We might move this into solver_convt. It is
        * useful to have the solver as a thread.
        */
-      std::thread solver_job(
-        [&result, &runtime_solver]() { result = runtime_solver->dec_solve(); });
+      std::thread solver_job([&result, &runtime_solver]() {
+        result = runtime_solver->dec_solve_refined();
+      });
 
       const bool fail_fast = options.get_bool_option("multi-fail-fast");
       // This loop is mainly for fail-fast.
@@ -833,7 +1337,8 @@ smt_convt::resultt bmct::multi_property_check(
               tracked_instrument++;
           }
         }
-        // TODO: This is the place to store into a cache
+        else if(result == smt_convt::P_UNSATISFIABLE && proven_cache)
+          proven_cache->insert(digest);
       }
       catch(...)
       {
@@ -844,32 +1349,138 @@ smt_convt::resultt bmct::multi_property_check(
   // PARALLEL
   if(options.get_bool_option("parallel-solving"))
   {
-    /* NOTE: I would love to use std::for_each here, but it is not giving
-       * the result I would expect. My guess is either compiler version
-       * or some magic flag that we are not using.
-       *
-       * Nevertheless, we can achieve the same results by just creating
-       * threads.
-       */
+    /* Every job holds its own copy of the equation and its own solver, so
+     * running one thread per claim does not scale. Instead, a fixed number
+     * of workers picks claims from a work-stealing queue, which bounds
+     * both the number of threads and the memory in use at any time.
+     */
+    size_t workers = work_stealing_pool::default_size();
+    const std::string parallel_jobs = options.get_option("parallel-jobs");
+    if(!parallel_jobs.empty())
+      workers = std::max(1, atoi(parallel_jobs.c_str()));
+    workers = std::min(workers, jobs.size());
 
-    // TODO: Running everything in parallel might be a bad idea.
-    //       Should we also add a thread pool?
-    std::vector<std::thread> parallel_jobs;
-    for(const auto &i : jobs)
-      parallel_jobs.push_back(std::thread(job_function, i));
+    log_status(
+      "Solving {} claim(s) using {} worker thread(s)", jobs.size(), workers);
 
-    // Main driver
-    for(auto &t : parallel_jobs)
-    {
-      t.join();
-    }
-    // We could remove joined jobs from the parallel_jobs vector.
-    // However, its probably not worth for small vectors.
+    work_stealing_pool pool(workers);
+    for(const auto &i : jobs)
+      pool.submit([&job_function, i]() { job_function(i); });
+    pool.wait();
   }
   // SEQUENTIAL
   else
     std::for_each(std::begin(jobs), std::end(jobs), job_function);
 
+  if(proven_cache)
+    proven_cache->save();
+
+  report_multi_property_coverage(tracked_instrument);
+  return final_result;
+}
+
+smt_convt::resultt
+bmct::multi_property_incremental(std::shared_ptr<symex_target_equationt> &eq)
+{
+  assert(
+    options.get_bool_option("base-case") &&
+    "Multi-property only supports base-case");
+
+  /* Unlike multi_property_check, the equation is encoded once, into
+   * runtime_solver, with the violation of each claim guarded by a selector.
+   * The claims are then solved in turn, each under the assumption of its
+   * selector, so that the solver keeps what it learned about the shared
+   * part of the formula from one claim to the next. Claims are not sliced
+   * one by one, and the proven claims cache is not used.
+   */
+  std::vector<symex_target_equationt::SSA_stepst::iterator> claims;
+  smt_convt::ast_vec selectors;
+
+  log_status("Encoding remaining VCC(s) with one selector per claim");
+  fine_timet encode_start = current_time();
+  eq->convert_claims(*runtime_solver, claims, selectors);
+  fine_timet encode_stop = current_time();
+  log_status(
+    "Encoding to solver time: {}s", time2string(encode_stop - encode_start));
+
+  smt_astt false_val = runtime_solver->convert_ast(gen_false_expr());
+  const bool fail_fast = options.get_bool_option("multi-fail-fast");
+  smt_convt::resultt final_result = smt_convt::P_UNSATISFIABLE;
+  size_t ce_counter = 0;
+  int tracked_instrument = 0;
+
+  for(size_t i = 0; i < claims.size(); i++)
+  {
+    const std::string &claim_msg = claims[i]->comment;
+    log_status(
+      "Solving claim '{}' with solver {}",
+      claim_msg,
+      runtime_solver->solver_text());
+
+    fine_timet sat_start = current_time();
+    smt_convt::resultt result =
+      runtime_solver->dec_solve_refined({selectors[i]});
+    fine_timet sat_stop = current_time();
+    log_status(
+      "Runtime decision procedure: {}s", time2string(sat_stop - sat_start));
+    report_multi_property_trace(result, claim_msg);
+
+    if(result == smt_convt::P_UNSATISFIABLE)
+    {
+      // The claim holds, which the remaining ones may as well rely on
+      runtime_solver->assert_ast(claims[i]->cond_ast);
+      continue;
+    }
+
+    if(result != smt_convt::P_SATISFIABLE)
+      return result;
+
+    // Leave the other claims out of the counterexample
+    std::vector<smt_astt> guards;
+    for(size_t j = 0; j < claims.size(); j++)
+    {
+      guards.push_back(claims[j]->guard_ast);
+      if(j != i)
+        claims[j]->guard_ast = false_val;
+    }
+
+    goto_tracet goto_trace;
+    build_goto_trace(eq, runtime_solver, goto_trace, false);
+
+    for(size_t j = 0; j < claims.size(); j++)
+      claims[j]->guard_ast = guards[j];
+
+    std::string output_file = options.get_option("cex-output");
+    if(output_file != "")
+    {
+      std::ofstream out(fmt::format("{}-{}", output_file, ce_counter++));
+      show_goto_trace(out, ns, goto_trace);
+    }
+    std::ostringstream oss;
+    log_fail("\n[Counterexample]\n");
+    show_goto_trace(oss, ns, goto_trace);
+    log_result("{}", oss.str());
+    final_result = result;
+
+    if(
+      options.get_bool_option("goto-coverage") ||
+      options.get_bool_option("make-assert-false") ||
+      options.get_bool_option("add-false-assert"))
+    {
+      if(claim_msg.find("Instrumentation") != std::string::npos)
+        tracked_instrument++;
+    }
+
+    if(fail_fast)
+      break;
+  }
+
+  report_multi_property_coverage(tracked_instrument);
+  return final_result;
+}
+
+void bmct::report_multi_property_coverage(int tracked_instrument)
+{
   if(
     options.get_bool_option("make-assert-false") &&
     !(options.get_bool_option("goto-coverage") ||
@@ -884,6 +1495,4 @@ smt_convt::resultt bmct::multi_property_check(
       log_result("  Coverage: {}%", tracked_instrument * 100.0 / total);
     }
   }
-
-  return final_result;
 }
@@ -12,6 +12,43 @@
 #include <solvers/solve.h>
 #include <util/options.h>
 #include <util/algorithms.h>
+#include <util/cache.h>
+
+/**
+ * @brief Solver kept alive across the bounds of one k-induction step
+ * (--k-induction-incremental).
+ *
+ * The equation for bound k+1 usually starts with the same steps as the one
+ * for bound k. The definitions among those shared steps are asserted once, at
+ * the base context level of the solver; the rest of the equation is encoded
+ * in a pushed context, which is popped before the next bound. ASTs converted
+ * for the shared steps and whatever the solver learned from them carry over.
+ */
+class incremental_bmc_solvert
+{
+public:
+  incremental_bmc_solvert(const contextt &context, const optionst &opts);
+
+  /**
+   * @brief Returns the solver \eq is to be encoded into: the definitions
+   * \eq shares with the equation of the previous call are already asserted,
+   * and a fresh context is pushed for everything else.
+   */
+  std::shared_ptr<smt_convt> &
+  prepare(const std::shared_ptr<symex_target_equationt> &eq);
+
+private:
+  namespacet ns;
+  /// Copied when the solver is created: the options it was given are flipped
+  /// between the k-induction steps and may not outlive it
+  const optionst options;
+
+  std::shared_ptr<smt_convt> solver;
+  std::shared_ptr<symex_target_equationt> last_eq;
+  /// Leading steps of last_eq whose definitions are in the base context
+  size_t stable = 0;
+  bool pushed = false;
+};
 
 class bmct
 {
@@ -20,6 +57,9 @@ public:
 
   optionst &options;
 
+  /// If set, solve with this solver instead of creating a new one
+  std::shared_ptr<incremental_bmc_solvert> incremental_solver;
+
   BigInt interleaving_number;
   BigInt interleaving_failed;
 
@@ -33,6 +73,8 @@ protected:
 
   std::shared_ptr<smt_convt> runtime_solver;
   std::shared_ptr<reachability_treet> symex;
+  /// Formulas proven in previous runs (--cache-asserts-file)
+  std::shared_ptr<persistent_assert_cache> proven_cache;
   virtual smt_convt::resultt run_decision_procedure(
     std::shared_ptr<smt_convt> &smt_conv,
     std::shared_ptr<symex_target_equationt> &eq);
@@ -70,9 +112,30 @@ protected:
     std::shared_ptr<symex_target_equationt> &eq);
 
   smt_convt::resultt run_thread(std::shared_ptr<symex_target_equationt> &eq);
+
+  /// Solves every interleaving in turn, until a counterexample is found
+  /// (unless --all-runs is set)
+  smt_convt::resultt
+  run_interleavings(std::shared_ptr<symex_target_equationt> &eq);
+
+  /// Splits the interleavings among \workers processes running
+  /// run_interleavings; stops all of them on the first counterexample
+  smt_convt::resultt run_interleaving_workers(unsigned workers);
+
+  /// Encodes and solves \p eq with each of \p solvers in its own process, and
+  /// returns the first SAT or UNSAT answer. The counterexample of a SAT
+  /// answer is then computed again in this process, by the winner alone.
+  smt_convt::resultt run_portfolio(
+    std::shared_ptr<symex_target_equationt> &eq,
+    const std::vector<std::string> &solvers);
   smt_convt::resultt multi_property_check(
     std::shared_ptr<symex_target_equationt> &eq,
     size_t remaining_claims);
+  /// Checks every claim of \p eq in turn with runtime_solver, which
+  /// encodes \p eq once and then solves under one assumption per claim
+  smt_convt::resultt
+  multi_property_incremental(std::shared_ptr<symex_target_equationt> &eq);
+  void report_multi_property_coverage(int tracked_instrument);
   std::vector<std::unique_ptr<ssa_step_algorithm>> algorithms;
 
   void generate_smt_from_equation(
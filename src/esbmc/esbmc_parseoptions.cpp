@@ -19,6 +19,7 @@ extern "C"
 #include <esbmc/bmc.h>
 #include <esbmc/esbmc_parseoptions.h>
 #include <cctype>
+#include <cerrno>
 #include <clang-c-frontend/clang_c_language.h>
 #include <util/config.h>
 #include <csignal>
@@ -176,6 +177,34 @@ uint64_t esbmc_parseoptionst::read_mem_spec(const char *str)
   return size;
 }
 
+/// The value of \p option, which must be a number from \p min to \p max
+static int ranged_option(
+  const cmdlinet &cmdline,
+  const char *option,
+  unsigned long min,
+  unsigned long max,
+  const char *what)
+{
+  const char *str = cmdline.getval(option);
+  char *end;
+  errno = 0;
+  unsigned long value = strtoul(str, &end, 10);
+  if(
+    !isdigit(str[0]) || *end != '\0' || errno == ERANGE || value < min ||
+    value > max)
+  {
+    log_error(
+      "--{} expects a number of {} from {} to {}, not {}",
+      option,
+      what,
+      min,
+      max,
+      str);
+    exit(1);
+  }
+  return value;
+}
+
 static std::string format_target()
 {
   const char *endian = nullptr;
@@ -220,6 +249,10 @@ void esbmc_parseoptionst::get_command_line_options(optionst &options)
   options.cmdline(cmdline);
   set_verbosity_msg();
 
+  // Must happen before any irep2 is built, so that all of them are shared
+  if(cmdline.isset("hash-consing"))
+    irep_interningt::enable(true);
+
   if(cmdline.isset("cex-output"))
     options.set_option("cex-output", cmdline.getval("cex-output"));
 
@@ -298,6 +331,16 @@ void esbmc_parseoptionst::get_command_line_options(optionst &options)
     }
   }
 
+  // Every worker is a process of its own
+  options.set_option(
+    "parallel-interleavings",
+    ranged_option(cmdline, "parallel-interleavings", 1, 256, "workers"));
+  // The defaults of options with a value are not in the optionst
+  options.set_option(
+    "interleaving-split-depth",
+    ranged_option(
+      cmdline, "interleaving-split-depth", 1, 1024, "context switches"));
+
   // check the user's parameters to run incremental verification
   if(!cmdline.isset("unlimited-k-steps"))
   {
@@ -406,8 +449,11 @@ void esbmc_parseoptionst::get_command_line_options(optionst &options)
   }
 #endif
 
-  // parallel solving activates "--multi-property"
-  if(cmdline.isset("parallel-solving"))
+  // parallel solving activates "--multi-property", and so does checking
+  // the claims incrementally
+  if(
+    cmdline.isset("parallel-solving") ||
+    cmdline.isset("multi-property-incremental"))
   {
     options.set_option("result-only", true);
     options.set_option("base-case", true);
@@ -1262,6 +1308,7 @@ int esbmc_parseoptionst::do_base_case(
   opts.set_option("partial-loops", false);
 
   bmct bmc(goto_functions, opts, context);
+  use_incremental_solver(bmc, base_case_solver);
 
   bmc.options.set_option("unwind", integer2string(k_step));
 
@@ -1308,6 +1355,7 @@ int esbmc_parseoptionst::do_forward_condition(
   opts.set_option("no-assertions", true);
 
   bmct bmc(goto_functions, opts, context);
+  use_incremental_solver(bmc, forward_condition_solver);
 
   bmc.options.set_option("unwind", integer2string(k_step));
 
@@ -1364,6 +1412,7 @@ int esbmc_parseoptionst::do_inductive_step(
   opts.set_option("partial-loops", true);
 
   bmct bmc(goto_functions, opts, context);
+  use_incremental_solver(bmc, inductive_step_solver);
   bmc.options.set_option("unwind", integer2string(k_step));
 
   log_progress("Checking inductive step, k = {:d}", k_step);
@@ -1389,6 +1438,18 @@ int esbmc_parseoptionst::do_inductive_step(
   return true;
 }
 
+void esbmc_parseoptionst::use_incremental_solver(
+  bmct &bmc,
+  std::shared_ptr<incremental_bmc_solvert> &solver)
+{
+  if(!bmc.options.get_bool_option("k-induction-incremental"))
+    return;
+
+  if(!solver)
+    solver = std::make_shared<incremental_bmc_solvert>(context, bmc.options);
+  bmc.incremental_solver = solver;
+}
+
 bool esbmc_parseoptionst::set_claims(goto_functionst &goto_functions)
 {
   try
@@ -61,6 +61,12 @@ protected:
     goto_functionst &goto_functions,
     const BigInt &k_step);
 
+  /// Hands \solver (created on first use) over to \bmc when
+  /// --k-induction-incremental is set
+  void use_incremental_solver(
+    bmct &bmc,
+    std::shared_ptr<incremental_bmc_solvert> &solver);
+
   bool read_goto_binary(goto_functionst &goto_functions);
 
   bool set_claims(goto_functionst &goto_functions);
@@ -77,6 +83,11 @@ protected:
   FILE *out = stdout;
   FILE *err = stderr;
 
+  /// Solvers kept across bounds by --k-induction-incremental, one per step
+  std::shared_ptr<incremental_bmc_solvert> base_case_solver;
+  std::shared_ptr<incremental_bmc_solvert> forward_condition_solver;
+  std::shared_ptr<incremental_bmc_solvert> inductive_step_solver;
+
   std::vector<std::unique_ptr<goto_functions_algorithm>>
     goto_preprocess_algorithms;
 
@@ -78,12 +78,26 @@ const struct group_opt_templ all_cmd_options[] = {
     {"sysroot",
      boost::program_options::value<std::string>()->value_name("<path>"),
      "set the sysroot for the frontend"},
+    {"parse-jobs",
+     boost::program_options::value<int>()->default_value(1)->value_name("nr"),
+     "parse up to nr input files at a time (C and C++ files only)"},
+    {"clang-pch-cache",
+     boost::program_options::value<std::string>()->value_name("<dir>"),
+     "reuse the intrinsics precompiled by clang in dir"},
     {"no-abstracted-cpp-includes",
      NULL,
      "do not include abstract cpp operational models"},
     {"force,f", boost::program_options::value<std::vector<std::string>>(), ""},
     {"preprocess", NULL, "stop after preprocessing"},
     {"cache-asserts", NULL, "cache asserts that were already proven correct"},
+    {"hash-consing",
+     NULL,
+     "share structurally identical expressions and types (saves memory on "
+     "large programs)"},
+    {"cache-asserts-file",
+     boost::program_options::value<std::string>()->value_name("file"),
+     "load formulas proven correct by previous runs from file, and store "
+     "newly proven ones into it"},
     {"no-inlining", NULL, "disable inlining function calls"},
     {"full-inlining", NULL, "perform full inlining of function calls"},
     {"all-claims", NULL, "keep all claims"},
@@ -204,6 +218,10 @@ const struct group_opt_templ all_cmd_options[] = {
     {"parallel-solving",
      NULL,
      "solve each VCC in parallel (this activates --multi-property)"},
+    {"parallel-jobs",
+     boost::program_options::value<int>()->value_name("nr"),
+     "number of worker threads used by --parallel-solving (default is the "
+     "number of available cores)"},
     {"smtlib", NULL, "use SMT lib format"},
     {"default-solver",
      boost::program_options::value<std::string>()->value_name("<solver>"),
@@ -212,6 +230,11 @@ const struct group_opt_templ all_cmd_options[] = {
      " (Boolector)"
 #endif
     },
+    {"portfolio",
+     boost::program_options::value<std::string>()->value_name("<solvers>"),
+     "solve each VCC with all the comma separated solvers in parallel "
+     "processes, taking the first answer; the winning solver reports the "
+     "counterexample"},
     {"non-supported-models-as-zero",
      NULL,
      "if ESBMC can't extract a type/expression from the solver, then the value "
@@ -231,6 +254,10 @@ const struct group_opt_templ all_cmd_options[] = {
      NULL,
      "encode floating-point as bit-vectors(default for solvers that don't "
      "support the SMT floating-point theory)"},
+    {"fp-refinement",
+     NULL,
+     "with bit-vector encoded floating-point, bit-blast +, -, * and / only "
+     "when the model needs it"},
     {"tuple-node-flattener", NULL, "encode tuples using our tuple to node API"},
     {"tuple-sym-flattener",
      NULL,
@@ -258,6 +285,10 @@ const struct group_opt_templ all_cmd_options[] = {
    {{"multi-property",
      NULL,
      "verify satisfiability of all claims of the current bound"},
+    {"multi-property-incremental",
+     NULL,
+     "check all claims of the current bound with a single solver, one at a "
+     "time under assumptions (this activates --multi-property)"},
     {"no-assertions", NULL, "ignore assertions"},
     {"no-bounds-check", NULL, "do not do array bounds check"},
     {"no-div-by-zero-check", NULL, "do not do division by zero check"},
@@ -305,6 +336,10 @@ const struct group_opt_templ all_cmd_options[] = {
     {"k-induction-parallel",
      NULL,
      "prove by k-induction, running each step on a separate process"},
+    {"k-induction-incremental",
+     NULL,
+     "keep one solver per step across k, only encoding the constraints not "
+     "shared with the previous k {experimental}"},
     {"k-step",
      boost::program_options::value<int>()->default_value(1)->value_name("nr"),
      "set k increment (default is 1)"},
@@ -339,7 +374,14 @@ const struct group_opt_templ all_cmd_options[] = {
     {"no-por", NULL, "do not do partial order reduction"},
     {"all-runs",
      NULL,
-     "check all interleavings, even if a bug was already found"}}},
+     "check all interleavings, even if a bug was already found"},
+    {"parallel-interleavings",
+     boost::program_options::value<int>()->default_value(1)->value_name("nr"),
+     "explore the interleavings with nr worker processes"},
+    {"interleaving-split-depth",
+     boost::program_options::value<int>()->default_value(2)->value_name("nr"),
+     "give the workers the subtrees of interleavings after nr context "
+     "switches"}}},
   {"Miscellaneous options",
    {
 
@@ -395,6 +437,13 @@ const struct group_opt_templ all_cmd_options[] = {
      {"interval-analysis-narrowing",
       NULL,
       "enables use of narrowing in abstract states (Integers and Reals)"},
+     {"interval-analysis-no-widening",
+      NULL,
+      "disables widening at loop heads with thresholds (all)"},
+     {"interval-analysis-jobs",
+      boost::program_options::value<int>()->default_value(1)->value_name("nr"),
+      "analyse functions separately along the call graph, with nr threads "
+      "(less precise across calls; default 1: whole-program analysis)"},
      {"add-symex-value-sets",
       NULL,
       "enable value-set analysis for pointers and add assumes to the "
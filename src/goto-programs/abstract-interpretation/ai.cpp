@@ -3,12 +3,19 @@
 
 #include "ai.h"
 
+#include <algorithm>
 #include <cassert>
+#include <climits>
+#include <exception>
 #include <memory>
+#include <mutex>
 #include <sstream>
+#include <unordered_set>
 
 #include <util/std_code.h>
+#include <util/message.h>
 #include <util/std_expr.h>
+#include <util/thread_pool.h>
 
 void ai_baset::output(const goto_functionst &goto_functions, std::ostream &out)
   const
@@ -63,6 +70,114 @@ void ai_baset::initialize(const goto_programt &goto_program)
 
   forall_goto_program_instructions(i_it, goto_program)
     get_state(i_it).make_bottom();
+
+  compute_priorities(goto_program);
+  prepare_widening(goto_program);
+}
+
+void ai_baset::compute_priorities(const goto_programt &goto_program)
+{
+  if(goto_program.empty())
+    return;
+
+  // Postorder of a depth-first search from the first instruction. Every stack
+  // entry holds the successors of the instruction that are left to visit.
+  std::vector<goto_programt::const_targett> postorder;
+  std::unordered_set<
+    goto_programt::const_targett,
+    const_target_hash,
+    pointee_address_equalt>
+    visited;
+  std::vector<
+    std::pair<goto_programt::const_targett, goto_programt::const_targetst>>
+    stack;
+
+  auto push = [&](goto_programt::const_targett l) {
+    if(l == goto_program.instructions.end() || !visited.insert(l).second)
+      return;
+    goto_programt::const_targetst successors;
+    goto_program.get_successors(l, successors);
+    stack.emplace_back(l, std::move(successors));
+  };
+
+  push(goto_program.instructions.begin());
+  while(!stack.empty())
+  {
+    if(stack.back().second.empty())
+    {
+      postorder.push_back(stack.back().first);
+      stack.pop_back();
+      continue;
+    }
+
+    goto_programt::const_targett next = stack.back().second.front();
+    stack.back().second.pop_front();
+    push(next);
+  }
+
+  unsigned n = 0;
+  for(auto it = postorder.rbegin(); it != postorder.rend(); ++it)
+    priorities[*it] = n++;
+
+  // Unreachable instructions go last
+  forall_goto_program_instructions(i_it, goto_program)
+    if(!visited.count(i_it))
+      priorities[i_it] = n++;
+}
+
+static void
+collect_thresholds(const expr2tc &expr, std::set<BigInt> &thresholds)
+{
+  if(is_nil_expr(expr))
+    return;
+
+  if(is_constant_int2t(expr))
+  {
+    // Bounds are often just off a constant, e.g. i < N gives i <= N - 1
+    const BigInt &value = to_constant_int2t(expr).value;
+    thresholds.insert(value - 1);
+    thresholds.insert(value);
+    thresholds.insert(value + 1);
+    return;
+  }
+
+  expr->foreach_operand([&thresholds](const expr2tc &e) {
+    collect_thresholds(e, thresholds);
+  });
+}
+
+void ai_baset::prepare_widening(const goto_programt &goto_program)
+{
+  bool has_loops = false;
+  forall_goto_program_instructions(i_it, goto_program)
+  {
+    if(!i_it->is_backwards_goto())
+      continue;
+
+    has_loops = true;
+    for(const auto &target : i_it->targets)
+      widening_counts[target] = 0;
+  }
+
+  if(!has_loops)
+    return;
+
+  // In case the program was initialized before
+  forall_goto_program_instructions(i_it, goto_program)
+    predecessors.erase(i_it);
+
+  forall_goto_program_instructions(i_it, goto_program)
+  {
+    collect_thresholds(i_it->guard, thresholds);
+    if(i_it->is_assign())
+      collect_thresholds(i_it->code, thresholds);
+
+    goto_programt::const_targetst successors;
+    goto_program.get_successors(i_it, successors);
+    for(const auto &to_l : successors)
+      if(to_l != goto_program.instructions.end())
+        predecessors[to_l].push_back(i_it);
+  }
 }
 
 void ai_baset::initialize(const goto_functionst &goto_functions)
@@ -109,9 +224,110 @@ bool ai_baset::fixedpoint(
       new_data = true;
   }
 
+  if(widening)
+    narrowing(goto_program, goto_functions, ns);
+
   return new_data;
 }
 
+bool ai_baset::merge_or_widen(
+  const statet &src,
+  goto_programt::const_targett from,
+  goto_programt::const_targett to)
+{
+  auto it = widening ? widening_counts.find(to) : widening_counts.end();
+  if(it == widening_counts.end())
+    return merge(src, from, to);
+
+  if(it->second >= widening_delay)
+    return widen(src, from, to);
+
+  if(!merge(src, from, to))
+    return false;
+
+  it->second++;
+  return true;
+}
+
+void ai_baset::narrowing(
+  const goto_programt &goto_program,
+  const goto_functionst &goto_functions,
+  const namespacet &ns)
+{
+  if(goto_program.empty())
+    return;
+
+  // Nothing to do unless a loop head was widened
+  std::vector<goto_programt::const_targett> order;
+  bool widened = false;
+  forall_goto_program_instructions(i_it, goto_program)
+  {
+    order.push_back(i_it);
+    auto it = widening_counts.find(i_it);
+    if(it != widening_counts.end() && it->second >= widening_delay)
+      widened = true;
+  }
+
+  if(!widened)
+    return;
+
+  std::sort(
+    order.begin(),
+    order.end(),
+    [this](goto_programt::const_targett a, goto_programt::const_targett b) {
+      return priority(a) < priority(b);
+    });
+
+  // The states were a post-fixedpoint, recomputing any of them from their
+  // predecessors and keeping the intersection leaves one
+  const bool follow_calls =
+    !goto_functions.function_map.empty() && !call_effects;
+  for(unsigned round = 0; round < narrowing_rounds; round++)
+  {
+    bool changed = false;
+    for(const auto &l : order)
+    {
+      if(l == goto_program.instructions.begin())
+        continue;
+
+      auto preds_it = predecessors.find(l);
+      if(preds_it == predecessors.end())
+        continue;
+
+      const auto &preds = preds_it->second;
+      // The state after a call comes from the callee
+      if(std::any_of(
+           preds.begin(),
+           preds.end(),
+           [follow_calls](goto_programt::const_targett p) {
+             return follow_calls && p->is_function_call();
+           }))
+        continue;
+
+      std::unique_ptr<statet> recomputed(make_temporary_state(get_state(l)));
+      recomputed->make_bottom();
+      for(const auto &p : preds)
+      {
+        const statet &pred_state = get_state(p);
+        if(pred_state.is_bottom())
+          continue;
+
+        std::unique_ptr<statet> tmp_state(make_temporary_state(pred_state));
+        tmp_state->transform(p, l, *this, ns);
+        if(p->is_function_call() && call_effects)
+          havoc_call_effects(p, *tmp_state);
+        merge_into(*recomputed, *tmp_state, p, l);
+      }
+
+      if(narrow(*recomputed, l))
+        changed = true;
+    }
+
+    if(!changed)
+      break;
+  }
+}
+
 bool ai_baset::visit(
   goto_programt::const_targett l,
   working_sett &working_set,
@@ -137,7 +353,9 @@ bool ai_baset::visit(
 
     bool have_new_values = false;
 
-    if(l->is_function_call() && !goto_functions.function_map.empty())
+    if(
+      l->is_function_call() && !goto_functions.function_map.empty() &&
+      !call_effects)
     {
       // this is a big special case
       const code_function_call2t &code = to_code_function_call2t(l->code);
@@ -152,7 +370,10 @@ bool ai_baset::visit(
 
       new_values.transform(l, to_l, *this, ns);
 
-      if(merge(new_values, l, to_l))
+      if(l->is_function_call() && call_effects)
+        havoc_call_effects(l, new_values);
+
+      if(merge_or_widen(new_values, l, to_l))
         have_new_values = true;
     }
 
@@ -166,6 +387,29 @@ bool ai_baset::visit(
   return new_data;
 }
 
+void ai_baset::havoc_call_effects(
+  goto_programt::const_targett l_call,
+  statet &state) const
+{
+  assert(call_effects);
+  if(state.is_bottom())
+    return;
+
+  const expr2tc &function = to_code_function_call2t(l_call->code).function;
+  if(!is_symbol2t(function))
+  {
+    // We don't know what is called
+    state.make_top();
+    return;
+  }
+
+  // Functions without a body have no entry: only the return value changes
+  auto it = call_effects->find(to_symbol2t(function).thename);
+  if(it != call_effects->end())
+    for(const expr2tc &lhs : it->second)
+      state.havoc(lhs);
+}
+
 bool ai_baset::do_function_call(
   goto_programt::const_targett l_call,
   goto_programt::const_targett l_return,
@@ -274,3 +518,231 @@ void ai_baset::sequential_fixedpoint(
   if(f_it != goto_functions.function_map.end())
     fixedpoint(f_it->second.body, goto_functions, ns);
 }
+
+void ai_baset::parallel_fixedpoint(
+  const goto_functionst &goto_functions,
+  const namespacet &ns)
+{
+  typedef goto_functionst::function_mapt::const_iterator function_itt;
+
+  function_itt main_it =
+    goto_functions.function_map.find(goto_functions.main_id());
+  if(
+    main_it == goto_functions.function_map.end() ||
+    !main_it->second.body_available)
+    return;
+
+  // The call graph of the functions with a body reachable from the entry
+  // function, which is node 0. Along the way, collect the symbols every
+  // function assigns itself.
+  std::vector<function_itt> nodes;
+  std::unordered_map<irep_idt, unsigned, irep_id_hash> node_numbers;
+  std::vector<std::vector<unsigned>> callees;
+  // call sites into each function, with the function they are in
+  std::vector<std::vector<std::pair<goto_programt::const_targett, unsigned>>>
+    call_sites;
+  std::vector<std::unordered_set<expr2tc, irep2_hash>> assigned;
+
+  auto add_node = [&](function_itt f) -> unsigned {
+    auto res = node_numbers.emplace(f->first, nodes.size());
+    if(res.second)
+    {
+      nodes.push_back(f);
+      callees.emplace_back();
+      call_sites.emplace_back();
+      assigned.emplace_back();
+    }
+    return res.first->second;
+  };
+
+  add_node(main_it);
+  for(unsigned n = 0; n < nodes.size(); n++)
+  {
+    forall_goto_program_instructions(i_it, nodes[n]->second.body)
+    {
+      if(i_it->is_assign() && is_symbol2t(to_code_assign2t(i_it->code).target))
+        assigned[n].insert(to_code_assign2t(i_it->code).target);
+
+      if(!i_it->is_function_call())
+        continue;
+
+      const code_function_call2t &call = to_code_function_call2t(i_it->code);
+      if(!is_nil_expr(call.ret) && is_symbol2t(call.ret))
+        assigned[n].insert(call.ret);
+
+      if(!is_symbol2t(call.function))
+        continue;
+
+      function_itt f_it =
+        goto_functions.function_map.find(to_symbol2t(call.function).thename);
+      if(
+        f_it == goto_functions.function_map.end() ||
+        !f_it->second.body_available)
+        continue;
+
+      unsigned m = add_node(f_it);
+      callees[n].push_back(m);
+      call_sites[m].emplace_back(i_it, n);
+    }
+  }
+
+  // Strongly connected components (Tarjan's algorithm, with an explicit
+  // stack). They are found callees first.
+  const unsigned size = nodes.size();
+  std::vector<unsigned> index(size, UINT_MAX), low(size), scc_of(size);
+  std::vector<bool> on_stack(size, false);
+  std::vector<unsigned> stack;
+  std::vector<std::vector<unsigned>> sccs;
+  unsigned next_index = 0;
+
+  auto discover = [&](unsigned n) {
+    index[n] = low[n] = next_index++;
+    stack.push_back(n);
+    on_stack[n] = true;
+  };
+
+  std::vector<std::pair<unsigned, size_t>> dfs;
+  discover(0);
+  dfs.emplace_back(0, 0);
+  while(!dfs.empty())
+  {
+    const unsigned n = dfs.back().first;
+    if(dfs.back().second < callees[n].size())
+    {
+      const unsigned m = callees[n][dfs.back().second++];
+      if(index[m] == UINT_MAX)
+      {
+        discover(m);
+        dfs.emplace_back(m, 0);
+      }
+      else if(on_stack[m])
+        low[n] = std::min(low[n], index[m]);
+      continue;
+    }
+
+    dfs.pop_back();
+    if(!dfs.empty())
+      low[dfs.back().first] = std::min(low[dfs.back().first], low[n]);
+
+    if(low[n] != index[n])
+      continue;
+
+    sccs.emplace_back();
+    unsigned m;
+    do
+    {
+      m = stack.back();
+      stack.pop_back();
+      on_stack[m] = false;
+      scc_of[m] = sccs.size() - 1;
+      sccs.back().push_back(m);
+    } while(m != n);
+  }
+
+  // What a call may assign: the symbols assigned by the callee, or by the
+  // functions it calls in turn
+  std::unordered_map<irep_idt, std::vector<expr2tc>, irep_id_hash> effects;
+  std::vector<std::unordered_set<expr2tc, irep2_hash>> scc_effects(
+    sccs.size());
+  for(unsigned s = 0; s < sccs.size(); s++)
+  {
+    for(unsigned n : sccs[s])
+    {
+      scc_effects[s].insert(assigned[n].begin(), assigned[n].end());
+      for(unsigned m : callees[n])
+        if(scc_of[m] != s)
+          scc_effects[s].insert(
+            scc_effects[scc_of[m]].begin(), scc_effects[scc_of[m]].end());
+    }
+
+    for(unsigned n : sccs[s])
+      effects[nodes[n]->first].assign(
+        scc_effects[s].begin(), scc_effects[s].end());
+  }
+
+  // Every component is analysed after all of its callers. Those at the same
+  // depth, i.e. longest call chain from the entry, are independent.
+  std::vector<unsigned> depth(sccs.size(), 0);
+  std::vector<std::vector<unsigned>> levels;
+  for(unsigned s = sccs.size(); s-- > 0;)
+  {
+    if(depth[s] >= levels.size())
+      levels.resize(depth[s] + 1);
+    levels[depth[s]].push_back(s);
+
+    for(unsigned n : sccs[s])
+      for(unsigned m : callees[n])
+        if(scc_of[m] != s)
+          depth[scc_of[m]] = std::max(depth[scc_of[m]], depth[s] + 1);
+  }
+
+  // The edge from a call site to the head of the callee
+  auto enter = [&](goto_programt::const_targett l_call, unsigned n) -> bool {
+    const statet &call_state = get_state(l_call);
+    if(call_state.is_bottom())
+      return false;
+
+    goto_programt::const_targett l_begin =
+      nodes[n]->second.body.instructions.begin();
+    std::unique_ptr<statet> tmp_state(make_temporary_state(call_state));
+    tmp_state->transform(l_call, l_begin, *this, ns);
+    return merge(*tmp_state, l_call, l_begin);
+  };
+
+  // Only touches the states of the component's own functions, and reads
+  // those of its callers
+  auto analyse = [&](unsigned s) {
+    for(unsigned n : sccs[s])
+      for(const auto &site : call_sites[n])
+        if(scc_of[site.second] != s)
+          enter(site.first, n);
+
+    // Recursive calls feed the entries of the component until they are stable
+    bool new_entry = true;
+    while(new_entry)
+    {
+      for(unsigned n : sccs[s])
+        fixedpoint(nodes[n]->second.body, goto_functions, ns);
+
+      new_entry = false;
+      for(unsigned n : sccs[s])
+        for(const auto &site : call_sites[n])
+          if(scc_of[site.second] == s && enter(site.first, n))
+            new_entry = true;
+    }
+  };
+
+  log_debug(
+    "[ai] analysing {} functions in {} levels with {} jobs",
+    size,
+    levels.size(),
+    jobs);
+
+  call_effects = &effects;
+  std::exception_ptr failure;
+  std::mutex failure_lock;
+  {
+    work_stealing_pool pool(jobs);
+    for(const auto &level : levels)
+    {
+      for(unsigned s : level)
+        pool.submit([&analyse, &failure, &failure_lock, s]() {
+          try
+          {
+            analyse(s);
+          }
+          catch(...)
+          {
+            const std::lock_guard<std::mutex> lock(failure_lock);
+            if(!failure)
+              failure = std::current_exception();
+          }
+        });
+      pool.wait();
+    }
+  }
+  call_effects = nullptr;
+
+  if(failure)
+    std::rethrow_exception(failure);
+}
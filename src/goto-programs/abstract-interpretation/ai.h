@@ -7,10 +7,13 @@
 #include <iosfwd>
 #include <map>
 #include <memory>
+#include <set>
+#include <unordered_map>
 #include <goto-programs/abstract-interpretation/ai_domain.h>
 #include <goto-programs/goto_functions.h>
 #include <util/xml.h>
 #include <util/expr.h>
+#include <util/mp_arith.h>
 
 /**
  * This is the basic interface of the abstract interpreter with default
@@ -59,8 +62,6 @@ public:
     finalize();
   }
 
-  // TODO: add history (for widening!)
-
   virtual std::unique_ptr<statet>
   abstract_state_before(goto_programt::const_targett l) const = 0;
 
@@ -77,6 +78,37 @@ public:
   {
   }
 
+  /**
+   * @brief Analyse the functions separately, \p n at a time
+   *
+   * With more than one job, the fixedpoint over a module stops following
+   * calls into the callees. Instead, the functions are analysed along the
+   * call graph, callers before callees: the entry state of a function is the
+   * join of the states at its call sites, and a call havocs whatever the
+   * callee (or its own callees) may assign. Functions which don't reach each
+   * other are analysed concurrently. This is less precise across calls than
+   * the default, whole-program, fixedpoint.
+   */
+  void set_jobs(unsigned n)
+  {
+    jobs = n;
+  }
+
+  /**
+   * @brief Enables widening at loop heads (the default)
+   *
+   * The heads of the loops are the targets of backwards gotos, as in
+   * goto_loopst. After widening_delay merges that changed the state at a
+   * loop head, the domain widens it instead, up to the next of the
+   * thresholds: the integer constants of the program, and their neighbours.
+   * Once a function is stable, its states are then narrowed for a few
+   * rounds by recomputing them from their predecessors.
+   */
+  void set_widening(bool enable)
+  {
+    widening = enable;
+  }
+
   virtual void
   output(const goto_functionst &goto_functions, std::ostream &out) const;
 
@@ -95,9 +127,10 @@ protected:
   /* The fixedpoint is computed through a Work set algorithm which
    * consists in adding nodes that have changed with the current merge
   */
-  // the work-queue is sorted by location number
-  typedef std::unordered_map<unsigned, goto_programt::const_targett>
-    working_sett;
+  // the work-queue is sorted by priority, i.e. in reverse postorder, so that
+  // the predecessors of an instruction (but through back edges) are visited
+  // before it
+  typedef std::map<unsigned, goto_programt::const_targett> working_sett;
 
   goto_programt::const_targett get_next(working_sett &working_set);
 
@@ -105,9 +138,41 @@ protected:
   put_in_working_set(working_sett &working_set, goto_programt::const_targett l)
   {
     working_set.insert(
-      std::pair<unsigned, goto_programt::const_targett>(l->location_number, l));
+      std::pair<unsigned, goto_programt::const_targett>(priority(l), l));
   }
 
+  /// Reverse postorder index of \p l in its function, or its location number
+  /// if the function wasn't initialized
+  unsigned priority(goto_programt::const_targett l) const
+  {
+    auto it = priorities.find(l);
+    return it == priorities.end() ? l->location_number : it->second;
+  }
+
+  void compute_priorities(const goto_programt &goto_program);
+
+  /// Finds the loop heads, predecessors and thresholds of \p goto_program
+  void prepare_widening(const goto_programt &goto_program);
+
+  /// Merges \p src into the state at \p to, widening at loop heads
+  bool merge_or_widen(
+    const statet &src,
+    goto_programt::const_targett from,
+    goto_programt::const_targett to);
+
+  /// Descending iterations over a function whose states were widened
+  void narrowing(
+    const goto_programt &goto_program,
+    const goto_functionst &goto_functions,
+    const namespacet &ns);
+
+  bool widening = true;
+  static constexpr unsigned widening_delay = 2;
+  static constexpr unsigned narrowing_rounds = 2;
+
+  typedef std::set<BigInt> thresholdst;
+  thresholdst thresholds;
+
   // true = found something new
   bool fixedpoint(
     const goto_programt &goto_program,
@@ -121,6 +186,13 @@ protected:
     const goto_functionst &goto_functions,
     const namespacet &ns);
 
+  /// The fixedpoint of set_jobs(): per function, along the call graph
+  void parallel_fixedpoint(
+    const goto_functionst &goto_functions,
+    const namespacet &ns);
+
+  unsigned jobs = 1;
+
   // Visit performs one step of abstract interpretation from location l
   // Depending on the instruction type it may compute a number of "edges"
   // or applications of the abstract transformer
@@ -133,6 +205,9 @@ protected:
     const namespacet &ns);
 
   // function calls
+  void havoc_call_effects(goto_programt::const_targett l_call, statet &state)
+    const;
+
   bool do_function_call_rec(
     goto_programt::const_targett l_call,
     goto_programt::const_targett l_return,
@@ -153,6 +228,18 @@ protected:
     const statet &src,
     goto_programt::const_targett from,
     goto_programt::const_targett to) = 0;
+  // joins src into dest, which is not in the state map
+  virtual bool merge_into(
+    statet &dest,
+    const statet &src,
+    goto_programt::const_targett from,
+    goto_programt::const_targett to) = 0;
+  virtual bool widen(
+    const statet &src,
+    goto_programt::const_targett from,
+    goto_programt::const_targett to) = 0;
+  // narrows the state at l with src, a sound state recomputed for l
+  virtual bool narrow(const statet &src, goto_programt::const_targett l) = 0;
   // for concurrent fixedpoint
   virtual bool merge_shared(
     const statet &src,
@@ -162,6 +249,36 @@ protected:
   virtual statet &get_state(goto_programt::const_targett l) = 0;
   virtual const statet &find_state(goto_programt::const_targett l) const = 0;
   virtual std::unique_ptr<statet> make_temporary_state(const statet &s) = 0;
+
+private:
+  std::unordered_map<
+    goto_programt::const_targett,
+    unsigned,
+    const_target_hash,
+    pointee_address_equalt>
+    priorities;
+
+  /// How many merges changed the state at every loop head
+  std::unordered_map<
+    goto_programt::const_targett,
+    unsigned,
+    const_target_hash,
+    pointee_address_equalt>
+    widening_counts;
+
+  /// Predecessors of the instructions of the functions with loops
+  std::unordered_map<
+    goto_programt::const_targett,
+    std::vector<goto_programt::const_targett>,
+    const_target_hash,
+    pointee_address_equalt>
+    predecessors;
+
+  /// Symbols each function, or the functions it calls, may assign. Only set
+  /// while the parallel fixedpoint runs, which havocs them at calls instead
+  /// of analysing the callee.
+  const std::unordered_map<irep_idt, std::vector<expr2tc>, irep_id_hash>
+    *call_effects = nullptr;
 };
 
 // domainT is expected to be derived from ai_domain_baseT
@@ -224,6 +341,12 @@ protected:
   // this one creates states, if need be
   virtual statet &get_state(goto_programt::const_targett l) override
   {
+    // Unlike operator[], find doesn't modify the map: the parallel fixedpoint
+    // looks up the (already initialized) states of several functions at once
+    typename state_mapt::iterator it = state_map.find(l);
+    if(it != state_map.end())
+      return it->second;
+
     return state_map[l]; // calls default constructor
   }
 
@@ -247,6 +370,33 @@ protected:
       static_cast<const domainT &>(src), from, to);
   }
 
+  bool merge_into(
+    statet &dest,
+    const statet &src,
+    goto_programt::const_targett from,
+    goto_programt::const_targett to) override
+  {
+    return static_cast<domainT &>(dest).merge(
+      static_cast<const domainT &>(src), from, to);
+  }
+
+  bool widen(
+    const statet &src,
+    goto_programt::const_targett from,
+    goto_programt::const_targett to) override
+  {
+    statet &dest = get_state(to);
+    return static_cast<domainT &>(dest).widen(
+      static_cast<const domainT &>(src), from, to, thresholds);
+  }
+
+  bool narrow(const statet &src, goto_programt::const_targett l) override
+  {
+    statet &dest = get_state(l);
+    return static_cast<domainT &>(dest).narrow(
+      static_cast<const domainT &>(src));
+  }
+
   std::unique_ptr<statet> make_temporary_state(const statet &s) override
   {
     return std::make_unique<domainT>(static_cast<const domainT &>(s));
@@ -255,7 +405,10 @@ protected:
   void fixedpoint(const goto_functionst &goto_functions, const namespacet &ns)
     override
   {
-    sequential_fixedpoint(goto_functions, ns);
+    if(jobs > 1)
+      parallel_fixedpoint(goto_functions, ns);
+    else
+      sequential_fixedpoint(goto_functions, ns);
   }
 
 private:
@@ -62,6 +62,16 @@ public:
 
   virtual bool is_top() const = 0;
 
+  /// Forgets everything known about the l-value \p lhs, e.g. because a
+  /// function that was not analysed inline may have assigned it. Domains
+  /// which cannot do that precisely go to top.
+  virtual void havoc(const expr2tc &lhs)
+  {
+    (void)lhs;
+    if(!is_bottom())
+      make_top();
+  }
+
   /// also add
   ///
   ///   bool merge(const T &b, const_targett from, const_targett to);
@@ -73,6 +83,19 @@ public:
   ///
   /// PRECONDITION(from.is_dereferenceable(), "Must not be _::end()")
   /// PRECONDITION(to.is_dereferenceable(), "Must not be _::end()")
+  ///
+  /// For ait to widen at loop heads, also add
+  ///
+  ///   bool widen(const T &b, const_targett from, const_targett to,
+  ///              const std::set<BigInt> &thresholds);
+  ///
+  /// Like merge, but any bound which is not stable goes to the next
+  /// threshold, or to infinity, so that loops converge quickly. And
+  ///
+  ///   bool narrow(const T &b);
+  ///
+  /// This refines "this" with "b", another sound state for the same
+  /// instruction (e.g. the intersection). Return true if "this" has changed.
 
   /// This method allows an expression to be simplified / evaluated using the
   /// current state.  It is used to evaluate assertions and in program
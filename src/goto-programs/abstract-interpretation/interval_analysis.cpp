@@ -3,6 +3,8 @@
 
 #include <goto-programs/abstract-interpretation/interval_analysis.h>
 #include <goto-programs/abstract-interpretation/interval_domain.h>
+#include <algorithm>
+#include <cstdlib>
 #include <unordered_set>
 
 static inline void get_symbols(
@@ -123,6 +125,10 @@ void interval_analysis(
 {
   ait<interval_domaint> interval_analysis;
   interval_domaint::set_options(options);
+  interval_analysis.set_widening(
+    !options.get_bool_option("interval-analysis-no-widening"));
+  interval_analysis.set_jobs(
+    std::max(1, atoi(options.get_option("interval-analysis-jobs").c_str())));
   interval_analysis(goto_functions, ns);
 
   if(options.get_bool_option("interval-analysis-dump"))
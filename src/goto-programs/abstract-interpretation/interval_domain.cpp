@@ -246,6 +246,60 @@ interval_domaint::get_top_interval_from_expr(const expr2tc &e) const
   return result;
 }
 
+template <class T>
+T interval_domaint::widen_intervals(
+  const T &before,
+  const T &after,
+  const std::set<BigInt> &thresholds)
+{
+  T result = after;
+
+  if(before.lower_set && after.lower_set && after.lower < before.lower)
+  {
+    // Largest threshold below the new bound
+    auto it = thresholds.upper_bound(after.lower);
+    if(it == thresholds.begin())
+      result.lower_set = false;
+    else
+      result.lower = *--it;
+  }
+
+  if(before.upper_set && after.upper_set && after.upper > before.upper)
+  {
+    // Smallest threshold above the new bound
+    auto it = thresholds.lower_bound(after.upper);
+    if(it == thresholds.end())
+      result.upper_set = false;
+    else
+      result.upper = *it;
+  }
+
+  return result;
+}
+
+template <>
+real_intervalt interval_domaint::widen_intervals(
+  const real_intervalt &before,
+  const real_intervalt &after,
+  const std::set<BigInt> &)
+{
+  real_intervalt result = after;
+  if(before.lower_set && after.lower_set && after.lower < before.lower)
+    result.lower_set = false;
+  if(before.upper_set && after.upper_set && after.upper > before.upper)
+    result.upper_set = false;
+  return result;
+}
+
+template <>
+wrapped_interval interval_domaint::widen_intervals(
+  const wrapped_interval &before,
+  const wrapped_interval &after,
+  const std::set<BigInt> &)
+{
+  return wrapped_interval::extrapolate_to(before, after);
+}
+
 template <class T>
 T interval_domaint::interpolate_intervals(const T &before, const T &after)
 {
@@ -763,6 +817,96 @@ bool interval_domaint::join(
   return result;
 }
 
+template <class IntervalMap>
+bool interval_domaint::widen(
+  IntervalMap &new_map,
+  const IntervalMap &previous_map,
+  const std::set<BigInt> &thresholds)
+{
+  bool result = false;
+  for(auto new_it = new_map.begin(); new_it != new_map.end();) // no new_it++
+  {
+    const auto b_it = previous_map.find(new_it->first);
+    if(b_it == previous_map.end())
+    {
+      fixpoint_map.erase(new_it->first);
+      new_it = new_map.erase(new_it);
+      result = true;
+      continue;
+    }
+
+    auto joined = new_it->second;
+    joined.join(b_it->second);
+    if(joined != new_it->second)
+    {
+      new_it->second = widen_intervals(new_it->second, joined, thresholds);
+      result = true;
+    }
+    new_it++;
+  }
+  return result;
+}
+
+bool interval_domaint::widen(
+  const interval_domaint &b,
+  goto_programt::const_targett,
+  goto_programt::const_targett,
+  const std::set<BigInt> &thresholds)
+{
+  if(b.is_bottom())
+    return false;
+  if(is_bottom())
+  {
+    *this = b;
+    return true;
+  }
+
+  bool result = widen(int_map, b.int_map, thresholds);
+  result |= widen(real_map, b.real_map, thresholds);
+  result |= widen(wrap_map, b.wrap_map, thresholds);
+  return result;
+}
+
+template <class IntervalMap>
+bool interval_domaint::narrow(
+  IntervalMap &new_map,
+  const IntervalMap &previous_map)
+{
+  bool result = false;
+  for(const auto &b : previous_map)
+  {
+    auto it = new_map.find(b.first);
+    if(it == new_map.end())
+    {
+      // We had top
+      new_map.insert(b);
+      result = true;
+      continue;
+    }
+
+    auto before = it->second;
+    it->second.meet(b.second);
+    if(it->second != before)
+      result = true;
+  }
+  return result;
+}
+
+bool interval_domaint::narrow(const interval_domaint &b)
+{
+  if(is_bottom())
+    return false;
+  if(b.is_bottom())
+  {
+    make_bottom();
+    return true;
+  }
+
+  bool result = narrow(int_map, b.int_map);
+  result |= narrow(real_map, b.real_map);
+  return result;
+}
+
 bool interval_domaint::join(const interval_domaint &b)
 {
   if(b.is_bottom())
@@ -111,6 +111,27 @@ public:
     return join(b);
   }
 
+  /**
+   * @brief Joins b into *this, but the bounds which are not stable move to
+   * the next threshold (Integers) or to infinity (Reals). Wrapped intervals
+   * are extrapolated.
+   *
+   * @return True if *this has changed
+   */
+  bool widen(
+    const interval_domaint &b,
+    goto_programt::const_targett,
+    goto_programt::const_targett,
+    const std::set<BigInt> &thresholds);
+
+  /**
+   * @brief Intersects *this with b, another sound state for the same
+   * instruction. Wrapped intervals are kept as they are.
+   *
+   * @return True if *this has changed
+   */
+  bool narrow(const interval_domaint &b);
+
   void clear_state()
   {
     int_map.clear();
@@ -138,6 +159,11 @@ public:
     make_top();
   }
 
+  void havoc(const expr2tc &lhs) final override
+  {
+    havoc_rec(lhs);
+  }
+
   bool is_bottom() const override final
   {
     return bottom;
@@ -283,6 +309,31 @@ protected:
   template <class Interval>
   Interval interpolate_intervals(const Interval &before, const Interval &after);
 
+  template <class IntervalMap>
+  bool widen(
+    IntervalMap &new_map,
+    const IntervalMap &previous_map,
+    const std::set<BigInt> &thresholds);
+
+  /**
+   * @brief Applies widening with thresholds
+   *
+   * Given two intervals: (a0, b0) (before the computation) and (a1, b1) (after the computation):
+   *
+   * Widening((a0,b0), (a1,b1)) = (a1 < a0 ? max{t <= a1} : a0, b1 > b0 ? min{t >= b1} : b0 )
+   *
+   * where t ranges over the thresholds, and the bound is infinite if there is no such t.
+   * @tparam Interval interval template specialization (Integers, Reals)
+   */
+  template <class Interval>
+  Interval widen_intervals(
+    const Interval &before,
+    const Interval &after,
+    const std::set<BigInt> &thresholds);
+
+  template <class IntervalMap>
+  bool narrow(IntervalMap &new_map, const IntervalMap &previous_map);
+
   /**
    * @brief Applies  LHS < RHS
    *
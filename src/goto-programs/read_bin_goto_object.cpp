@@ -1,46 +1,157 @@
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/stream.hpp>
 #include <goto-programs/goto_function_serialization.h>
 #include <goto-programs/goto_program_irep.h>
 #include <goto-programs/read_bin_goto_object.h>
+#include <goto-programs/write_goto_binary.h>
 #include <langapi/mode.h>
 #include <util/base_type.h>
+#include <util/irep_flat_serialization.h>
 #include <util/irep_serialization.h>
 #include <util/namespace.h>
 #include <util/symbol_serialization.h>
 
-#define BINARY_VERSION 1
+static void
+add_symbol(const irept &t, contextt &context, goto_functionst &functions)
+{
+  symbolt symbol;
+  symbol.from_irep(t);
+
+  if(!symbol.is_type && symbol.type.is_code())
+  {
+    // makes sure there is an empty function
+    // for every function symbol and fixes
+    // the function types.
+    auto it = functions.function_map.find(symbol.id);
+    if(it == functions.function_map.end())
+      functions.function_map.emplace(symbol.id, goto_functiont());
+    functions.function_map.at(symbol.id).type = to_code_type(symbol.type);
+  }
+  context.add(symbol);
+}
+
+static void
+add_function(const irep_idt &fname, const irept &t, goto_functionst &functions)
+{
+  auto it = functions.function_map.find(fname);
+  if(it == functions.function_map.end())
+    functions.function_map.emplace(fname, goto_functiont());
+  goto_functiont &f = functions.function_map.at(fname);
+  convert(t, f.body);
+  f.body_available = f.body.instructions.size() > 0;
+}
+
+static bool bad_header(const char *hdr, const std::string &filename)
+{
+  if(hdr[0] == 'G' && hdr[1] == 'B' && hdr[2] == 'F')
+    return false;
+
+  std::ostringstream str;
+  if(hdr[0] == 0x7f && hdr[1] == 'E' && hdr[2] == 'L' && hdr[3] == 'F')
+  {
+    if(filename != "")
+      str << "Sorry, but I can't read ELF binary `" << filename << "'";
+    else
+      str << "Sorry, but I can't read ELF binaries";
+  }
+  else
+    str << "`" << filename << "' is not a goto-binary."
+        << "\n";
+
+  log_error("{}", str.str());
+  return true;
+}
+
+static void bad_version()
+{
+  log_error(
+    "The input was compiled with a different version of goto-cc, please "
+    "recompile");
+}
+
+/// Version 2: flat irep tables followed by the symbols and function bodies.
+/// Every symbol and body is built, each shared node only once.
+static bool read_flat_goto_object(
+  const uint8_t *data,
+  const uint8_t *end,
+  contextt &context,
+  goto_functionst &functions)
+{
+  irep_flat_readert flat;
+  data = flat.open(data, end);
+  if(!data || end - data < 4)
+  {
+    log_error("Truncated goto binary");
+    return true;
+  }
+
+  uint32_t count = irep_flat_readert::read_word(data);
+  data += 4;
+  if(size_t(end - data) / 4 < size_t(count) + 1)
+  {
+    log_error("Truncated goto binary");
+    return true;
+  }
+  for(uint32_t i = 0; i < count; i++, data += 4)
+    add_symbol(flat.get(irep_flat_readert::read_word(data)), context, functions);
+
+  assert(migrate_namespace_lookup);
+
+  count = irep_flat_readert::read_word(data);
+  data += 4;
+  if(size_t(end - data) / 8 < count)
+  {
+    log_error("Truncated goto binary");
+    return true;
+  }
+  for(uint32_t i = 0; i < count; i++, data += 8)
+    add_function(
+      flat.get_string(irep_flat_readert::read_word(data)),
+      flat.get(irep_flat_readert::read_word(data + 4)),
+      functions);
+
+  return false;
+}
 
 bool read_bin_goto_object(
-  std::istream &in,
+  const void *data,
+  size_t size,
   const std::string &filename,
   contextt &context,
   goto_functionst &functions)
 {
-  std::ostringstream str;
+  // The version is stored big endian right after the header
+  const uint8_t *bytes = static_cast<const uint8_t *>(data);
+  if(
+    size >= 7 && bytes[0] == 'G' && bytes[1] == 'B' && bytes[2] == 'F' &&
+    bytes[3] == 0 && bytes[4] == 0 && bytes[5] == 0 &&
+    bytes[6] == GOTO_BINARY_VERSION)
+    return read_flat_goto_object(bytes + 7, bytes + size, context, functions);
 
+  // Older versions and errors are dealt with by the stream reader
+  using namespace boost::iostreams;
+  stream<array_source> in(static_cast<const char *>(data), size);
+  return read_bin_goto_object(in, filename, context, functions);
+}
+
+bool read_bin_goto_object(
+  std::istream &in,
+  const std::string &filename,
+  contextt &context,
+  goto_functionst &functions)
+{
   {
     char hdr[4];
     hdr[0] = in.get();
     hdr[1] = in.get();
     hdr[2] = in.get();
+    hdr[3] = 0;
 
     if(hdr[0] != 'G' || hdr[1] != 'B' || hdr[2] != 'F')
-    {
       hdr[3] = in.get();
 
-      if(hdr[0] == 0x7f && hdr[1] == 'E' && hdr[2] == 'L' && hdr[3] == 'F')
-      {
-        if(filename != "")
-          str << "Sorry, but I can't read ELF binary `" << filename << "'";
-        else
-          str << "Sorry, but I can't read ELF binaries";
-      }
-      else
-        str << "`" << filename << "' is not a goto-binary."
-            << "\n";
-
-      log_error("{}", str.str());
+    if(bad_header(hdr, filename))
       abort();
-    }
   }
 
   irep_serializationt::ireps_containert ic;
@@ -48,16 +159,21 @@ bool read_bin_goto_object(
   symbol_serializationt symbolconverter(ic);
   goto_function_serializationt gfconverter(ic);
 
+  unsigned version = irepconverter.read_long(in);
+
+  if(version == GOTO_BINARY_VERSION)
   {
-    unsigned version = irepconverter.read_long(in);
+    // The flat format is read in place, from memory
+    std::string rest(
+      (std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    const uint8_t *data = reinterpret_cast<const uint8_t *>(rest.data());
+    return read_flat_goto_object(data, data + rest.size(), context, functions);
+  }
 
-    if(version != BINARY_VERSION)
-    {
-      str << "The input was compiled with a different version of "
-          << "goto-cc, please recompile";
-      log_error("{}", str.str());
-      abort();
-    }
+  if(version != 1)
+  {
+    bad_version();
+    abort();
   }
 
   unsigned count = irepconverter.read_long(in);
@@ -66,20 +182,7 @@ bool read_bin_goto_object(
   {
     irept t;
     symbolconverter.convert(in, t);
-    symbolt symbol;
-    symbol.from_irep(t);
-
-    if(!symbol.is_type && symbol.type.is_code())
-    {
-      // makes sure there is an empty function
-      // for every function symbol and fixes
-      // the function types.
-      auto it = functions.function_map.find(symbol.id);
-      if(it == functions.function_map.end())
-        functions.function_map.emplace(symbol.id, goto_functiont());
-      functions.function_map.at(symbol.id).type = to_code_type(symbol.type);
-    }
-    context.add(symbol);
+    add_symbol(t, context, functions);
   }
 
   assert(migrate_namespace_lookup);
@@ -90,12 +193,7 @@ bool read_bin_goto_object(
     irept t;
     dstring fname = irepconverter.read_string(in);
     gfconverter.convert(in, t);
-    auto it = functions.function_map.find(fname);
-    if(it == functions.function_map.end())
-      functions.function_map.emplace(fname, goto_functiont());
-    goto_functiont &f = functions.function_map.at(fname);
-    convert(t, f.body);
-    f.body_available = f.body.instructions.size() > 0;
+    add_function(fname, t, functions);
   }
 
   return false;
@@ -13,4 +13,13 @@ bool read_bin_goto_object(
   contextt &context,
   goto_functionst &functions);
 
+/** Like the above, but reads the object from memory. Version 2 objects are
+ *  parsed in place, without copying `data`. */
+bool read_bin_goto_object(
+  const void *data,
+  size_t size,
+  const std::string &filename,
+  contextt &context,
+  goto_functionst &functions);
+
 #endif /*READ_BIN_GOTO_OBJECT_H_*/
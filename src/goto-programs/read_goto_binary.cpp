@@ -2,7 +2,11 @@
 #include <goto-programs/read_goto_binary.h>
 #include <fstream>
 #include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
 #include <boost/iostreams/stream.hpp>
+#include <goto-programs/write_goto_binary.h>
+#include <util/irep_serialization.h>
+#include <util/symbol_serialization.h>
 
 bool read_goto_binary_array(
   const void *data,
@@ -10,9 +14,7 @@ bool read_goto_binary_array(
   contextt &context,
   goto_functionst &dest)
 {
-  using namespace boost::iostreams;
-  stream<array_source> src(static_cast<const char *>(data), size);
-  return read_bin_goto_object(src, "", context, dest);
+  return read_bin_goto_object(data, size, "", context, dest);
 }
 
 bool read_goto_binary(
@@ -20,6 +22,86 @@ bool read_goto_binary(
   contextt &context,
   goto_functionst &dest)
 {
+  // Map the file rather than reading it: version 2 binaries are parsed in
+  // place, and only the pages actually used are loaded.
+  boost::iostreams::mapped_file_source file;
+  try
+  {
+    file.open(path);
+  }
+  catch(const std::exception &)
+  {
+  }
+
+  if(file.is_open() && file.size() > 0)
+    return read_bin_goto_object(file.data(), file.size(), path, context, dest);
+
   std::ifstream in(path, std::ios::in | std::ios::binary);
   return read_bin_goto_object(in, path, context, dest);
 }
+
+bool indexed_goto_binaryt::open(const void *data, size_t data_size)
+{
+  using namespace boost::iostreams;
+  const char *bytes = static_cast<const char *>(data);
+  names.clear();
+  toc.clear();
+
+  if(data_size < 3 || bytes[0] != 'G' || bytes[1] != 'B' || bytes[2] != 'I')
+    return true;
+
+  stream<array_source> in(bytes + 3, data_size - 3);
+  irep_serializationt::ireps_containert ic;
+  irep_serializationt irepconverter(ic);
+
+  if(irepconverter.read_long(in) != GOTO_BINARY_INDEXED_VERSION)
+  {
+    log_error("Indexed goto binary has an unsupported version");
+    return true;
+  }
+
+  unsigned count = irepconverter.read_long(in);
+  names.reserve(count);
+  for(unsigned i = 0; i < count; i++)
+  {
+    irep_idt name = irepconverter.read_string(in);
+    size_t offset = irepconverter.read_long(in);
+    size_t len = irepconverter.read_long(in);
+    names.push_back(name);
+    toc.emplace(name, std::make_pair(offset, len));
+  }
+
+  if(!in.good())
+  {
+    log_error("Truncated indexed goto binary");
+    return true;
+  }
+
+  start = bytes + 3 + in.tellg();
+  size = data_size - 3 - in.tellg();
+  for(const auto &entry : toc)
+    if(entry.second.first + entry.second.second > size)
+    {
+      log_error("Corrupt indexed goto binary");
+      return true;
+    }
+
+  return false;
+}
+
+bool indexed_goto_binaryt::read_symbol(const irep_idt &id, symbolt &dest) const
+{
+  auto it = toc.find(id);
+  if(it == toc.end())
+    return true;
+
+  using namespace boost::iostreams;
+  stream<array_source> in(start + it->second.first, it->second.second);
+  irep_serializationt::ireps_containert ic;
+  symbol_serializationt symbolconverter(ic);
+
+  irept t;
+  symbolconverter.convert(in, t);
+  dest.from_irep(t);
+  return false;
+}
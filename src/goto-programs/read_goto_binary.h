@@ -2,6 +2,7 @@
 #define CPROVER_GOTO_PROGRAMS_READ_GOTO_BINARY_H
 
 #include <goto-programs/goto_functions.h>
+#include <unordered_map>
 #include <util/context.h>
 #include <util/message.h>
 #include <util/options.h>
@@ -17,4 +18,37 @@ bool read_goto_binary(
   contextt &context,
   goto_functionst &dest);
 
+/** Read-only view of an indexed goto binary (see write_goto_binary_indexed)
+ *  held in memory. Only the table of contents is parsed up front; symbols are
+ *  deserialized one by one, on request. The data must outlive this object. */
+class indexed_goto_binaryt
+{
+public:
+  /** Parses the table of contents of `data`.
+   *  @return true if `data` is not an indexed goto binary */
+  bool open(const void *data, size_t size);
+
+  /// Names of all symbols, in the order they were written
+  const std::vector<irep_idt> &symbols() const
+  {
+    return names;
+  }
+
+  bool has_symbol(const irep_idt &id) const
+  {
+    return toc.count(id) != 0;
+  }
+
+  /** Deserializes the symbol `id` into `dest`.
+   *  @return true if there is no such symbol */
+  bool read_symbol(const irep_idt &id, symbolt &dest) const;
+
+private:
+  const char *start = nullptr;
+  size_t size = 0;
+  std::vector<irep_idt> names;
+  /// Offset and size of every serialized symbol
+  std::unordered_map<irep_idt, std::pair<size_t, size_t>, irep_id_hash> toc;
+};
+
 #endif
@@ -1,6 +1,8 @@
 #include <fstream>
-#include <goto-programs/goto_function_serialization.h>
+#include <sstream>
+#include <goto-programs/goto_program_irep.h>
 #include <goto-programs/write_goto_binary.h>
+#include <util/irep_flat_serialization.h>
 #include <util/irep_serialization.h>
 #include <util/message.h>
 #include <util/symbol_serialization.h>
@@ -14,36 +16,73 @@ bool write_goto_binary(
   out << "GBF";
   write_long(out, GOTO_BINARY_VERSION);
 
-  irep_serializationt::ireps_containert irepc;
-  irep_serializationt irepconverter(irepc);
-  symbol_serializationt symbolconverter(irepc);
-  goto_function_serializationt gfconverter(irepc);
+  irep_flat_writert flat;
 
-  write_long(out, lcontext.size());
-
-  lcontext.foreach_operand([&symbolconverter, &out](const symbolt &s) {
-    symbolconverter.convert(s, out);
+  std::vector<unsigned> symbols;
+  lcontext.foreach_operand([&flat, &symbols](const symbolt &s) {
+    irept t;
+    s.to_irep(t);
+    symbols.push_back(flat.add(t));
   });
 
-  unsigned cnt = 0;
-  forall_goto_functions(it, functions)
-    if(it->second.body_available)
-      cnt++;
-
-  write_long(out, cnt);
-
+  std::vector<std::pair<unsigned, unsigned>> bodies;
   for(auto &it : functions.function_map)
   {
     if(it.second.body_available)
     {
       it.second.body.compute_location_numbers();
-      write_string(out, it.first.as_string());
-      gfconverter.convert(it.second, out);
+      irept t;
+      convert(it.second.body, t);
+      bodies.emplace_back(flat.add_string(it.first), flat.add(t));
     }
   }
 
-  //irepconverter.output_map(f);
-  //irepconverter.output_string_map(f);
+  flat.write(out);
+
+  irep_flat_writert::write_word(out, symbols.size());
+  for(unsigned s : symbols)
+    irep_flat_writert::write_word(out, s);
+
+  irep_flat_writert::write_word(out, bodies.size());
+  for(const auto &b : bodies)
+  {
+    irep_flat_writert::write_word(out, b.first);
+    irep_flat_writert::write_word(out, b.second);
+  }
+
+  return !out.good();
+}
+
+bool write_goto_binary_indexed(std::ostream &out, const contextt &lcontext)
+{
+  // Serialize every symbol with its own string and irep tables, so that no
+  // symbol refers back into another one.
+  std::vector<std::pair<irep_idt, std::string>> blobs;
+  lcontext.foreach_operand([&blobs](const symbolt &s) {
+    irep_serializationt::ireps_containert irepc;
+    symbol_serializationt symbolconverter(irepc);
+    std::ostringstream blob;
+    symbolconverter.convert(s, blob);
+    blobs.emplace_back(s.id, blob.str());
+  });
+
+  // header
+  out << "GBI";
+  write_long(out, GOTO_BINARY_INDEXED_VERSION);
+  write_long(out, blobs.size());
+
+  // table of contents, offsets are relative to the end of the table
+  unsigned offset = 0;
+  for(const auto &blob : blobs)
+  {
+    write_string(out, blob.first.as_string());
+    write_long(out, offset);
+    write_long(out, blob.second.size());
+    offset += blob.second.size();
+  }
+
+  for(const auto &blob : blobs)
+    out << blob.second;
 
-  return false;
+  return !out.good();
 }
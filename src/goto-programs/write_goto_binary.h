@@ -1,7 +1,8 @@
 #ifndef CPROVER_GOTO_PROGRAMS_WRITE_GOTO_BINARY_H_
 #define CPROVER_GOTO_PROGRAMS_WRITE_GOTO_BINARY_H_
 
-#define GOTO_BINARY_VERSION 1
+#define GOTO_BINARY_VERSION 2
+#define GOTO_BINARY_INDEXED_VERSION 1
 
 #include <goto-programs/goto_functions.h>
 #include <ostream>
@@ -12,4 +13,11 @@ bool write_goto_binary(
   const contextt &lcontext,
   goto_functionst &functions);
 
+/** Writes the symbols of `lcontext` as an indexed goto binary: a table of
+ *  contents mapping every symbol to the offset and size of its serialization,
+ *  followed by the symbols, each serialized on its own. Readers can thus
+ *  deserialize single symbols, see indexed_goto_binaryt.
+ *  @return true on error, false on success */
+bool write_goto_binary_indexed(std::ostream &out, const contextt &lcontext);
+
 #endif
@@ -1144,6 +1144,39 @@ static inline expr2tc gen_value_by_byte(
   return gen_byte_expression(type, src, value, num_of_bytes, offset);
 }
 
+// Simplifies the byte offset of an internal dereference item, returns
+// whether it is constant
+static bool simplify_item_offset(expr2tc &offset)
+{
+  simplify(offset);
+
+  /* TODO: Shouldn't the simplifier be able to solve pointer arithmethic
+   *  when it multiplies and divides for the same value?
+   */
+  if(is_div2t(offset))
+  {
+    auto as_div = to_div2t(offset);
+    if(is_mul2t(as_div.side_1) && is_constant_int2t(as_div.side_2))
+    {
+      auto as_mul = to_mul2t(as_div.side_1);
+      if(
+        is_constant_int2t(as_mul.side_2) &&
+        (to_constant_int2t(as_mul.side_2).as_ulong() ==
+         to_constant_int2t(as_div.side_2).as_ulong()))
+      {
+        // if side_1 of mult is a pointer_offset, then it is just zero
+        if(is_pointer_offset2t(as_mul.side_1))
+        {
+          log_debug("[intrinsics] TODO: some simplifications are missing");
+          offset = constant_int2tc(get_uint64_type(), BigInt(0));
+        }
+      }
+    }
+  }
+
+  return is_constant_int2t(offset);
+}
+
 void goto_symext::intrinsic_memset(
   reachability_treet &art,
   const code_function_call2t &func_call)
@@ -1196,18 +1229,7 @@ void goto_symext::intrinsic_memset(
   // Define a local function for translating to calling the unwinding C
   // implementation of memset
   auto bump_call = [this, &func_call]() -> void {
-    // We're going to execute a function call, and that's going to mess with
-    // the program counter. Set it back *onto* pointing at this intrinsic, so
-    // symex_function_call calculates the right return address. Misery.
-    cur_state->source.pc--;
-
-    expr2tc newcall = func_call.clone();
-    code_function_call2t &mutable_funccall = to_code_function_call2t(newcall);
-    mutable_funccall.function =
-      symbol2tc(get_empty_type(), "c:@F@__memset_impl");
-    // Execute call
-    symex_function_call(newcall);
-    return;
+    bump_intrinsic_call(func_call, "c:@F@__memset_impl");
   };
 
   /* Get the arguments
@@ -1272,50 +1294,11 @@ void goto_symext::intrinsic_memset(
       return;
     }
 
-    simplify(item_offset);
     // We can't optimize symbolic offsets :/
-    if(is_symbol2t(item_offset))
+    if(!simplify_item_offset(item_offset))
     {
-      log_debug(fmt::format(
-        "[memset] Item offset is symbolic: {}",
-        to_symbol2t(item_offset).get_symbol_name()));
-      bump_call();
-      return;
-    }
-
-    /* TODO: Shouldn't the simplifier be able to solve pointer arithmethic
-     *  when it multiplies and divides for the same value?
-     */
-    if(is_div2t(item_offset))
-    {
-      auto as_div = to_div2t(item_offset);
-      if(is_mul2t(as_div.side_1) && is_constant_int2t(as_div.side_2))
-      {
-        auto as_mul = to_mul2t(as_div.side_1);
-        if(
-          is_constant_int2t(as_mul.side_2) &&
-          (to_constant_int2t(as_mul.side_2).as_ulong() ==
-           to_constant_int2t(as_div.side_2).as_ulong()))
-        {
-          // if side_1 of mult is a pointer_offset, then it is just zero
-          if(is_pointer_offset2t(as_mul.side_1))
-          {
-            log_debug("[memset] TODO: some simplifications are missing");
-            item_offset = constant_int2tc(get_uint64_type(), BigInt(0));
-          }
-        }
-      }
-    }
-
-    if(!is_constant_int2t(item_offset))
-    {
-      /* If we reached here, item_offset is not symbolic
-       * and we don't know what the actual value of it is...
-       *
-       * For now bump_call, later we should expand our simplifier
-       */
-      log_debug(
-        "[memset] TODO: some simplifications are missing, bumping call");
+      /* For now bump_call, later we should expand our simplifier */
+      log_debug("[memset] Item offset is not constant: {}", *item_offset);
       bump_call();
       return;
     }
@@ -1379,6 +1362,654 @@ void goto_symext::intrinsic_memset(
   symex_assign(code_assign2tc(ret_ref, arg0), false, cur_state->guard);
 }
 
+void goto_symext::bump_intrinsic_call(
+  const code_function_call2t &func_call,
+  const irep_idt &impl)
+{
+  // We're going to execute a function call, and that's going to mess with
+  // the program counter. Set it back *onto* pointing at this intrinsic, so
+  // symex_function_call calculates the right return address. Misery.
+  cur_state->source.pc--;
+
+  expr2tc newcall = func_call.clone();
+  code_function_call2t &mutable_funccall = to_code_function_call2t(newcall);
+  mutable_funccall.function = symbol2tc(get_empty_type(), impl);
+  // Execute call
+  symex_function_call(newcall);
+}
+
+void goto_symext::intrinsic_null_check(const expr2tc &ptr)
+{
+  if(options.get_bool_option("no-pointer-check"))
+    return;
+
+  symbol2tc null_sym(ptr->type, "NULL");
+  expr2tc null_check = not2tc(same_object2tc(ptr, null_sym));
+  cur_state->guard.guard_expr(null_check);
+  claim(null_check, "dereference failure: NULL pointer");
+}
+
+void goto_symext::intrinsic_valid_check(
+  const std::list<dereference_callbackt::internal_item> &items)
+{
+  if(options.get_bool_option("no-pointer-check"))
+    return;
+
+  // As dereferencet::valid_check: dynamic objects may have been freed
+  for(const auto &item : items)
+  {
+    if(
+      !is_symbol2t(item.object) ||
+      !has_prefix(
+        to_symbol2t(item.object).thename.as_string(), "symex_dynamic::"))
+      continue;
+
+    guardt guard = cur_state->guard;
+    guard.add(item.guard);
+    guard.add(not2tc(
+      valid_object2tc(address_of2tc(item.object->type, item.object))));
+    expr2tc failed = guard.as_expr();
+    replace_dynamic_allocation(failed);
+    claim(not2tc(failed), "dereference failure: invalidated dynamic object");
+  }
+}
+
+bool goto_symext::get_constant_targets(
+  const expr2tc &ptr,
+  std::list<dereference_callbackt::internal_item> &items)
+{
+  // Unknown and invalid targets are left to the operational model, whose
+  // dereferences report them
+  expr2tc l1_ptr = ptr;
+  cur_state->top().level1.rename(l1_ptr);
+  value_setst::valuest values;
+  cur_state->value_set.get_value_set(l1_ptr, values);
+  for(const expr2tc &value : values)
+    if(is_unknown2t(value) || is_invalid2t(value))
+      return false;
+
+  internal_deref_items.clear();
+  dereference2tc deref(get_empty_type(), ptr);
+  dereference(deref, dereferencet::INTERNAL);
+
+  for(dereference_callbackt::internal_item item : internal_deref_items)
+  {
+    if(!item.object || !item.offset || is_code_type(item.object->type))
+      return false;
+
+    cur_state->rename(item.offset);
+    if(!simplify_item_offset(item.offset))
+      return false;
+
+    items.push_back(item);
+  }
+
+  // Locals whose frame is gone are left to the operational model as well
+  symex_dereference_statet deref_state(*this, *cur_state);
+  dereference_callbackt &callback = deref_state;
+  for(const auto &item : items)
+    if(is_symbol2t(item.object) && !callback.is_live_variable(item.object))
+      return false;
+
+  // Only NULL, which the operational model reports
+  return !items.empty();
+}
+
+// Size of objects of this type in bytes, or -1 if it isn't constant
+static BigInt constant_byte_size(const type2tc &type)
+{
+  try
+  {
+    return type_byte_size(type);
+  }
+  catch(const array_type2t::dyn_sized_array_excp &e)
+  {
+    return -1;
+  }
+  catch(const array_type2t::inf_sized_array_excp &e)
+  {
+    return -1;
+  }
+}
+
+// Whether the bytes of objects of this type can be extracted from their
+// value, i.e. they hold no pointers
+static bool is_plain_data(const type2tc &type)
+{
+  if(is_bool_type(type) || is_bv_type(type) || is_fractional_type(type))
+    return true;
+
+  if(is_array_type(type))
+    return is_plain_data(to_array_type(type).subtype);
+
+  if(is_struct_type(type) || is_union_type(type))
+  {
+    const std::vector<type2tc> &members =
+      static_cast<const struct_union_data &>(*type).members;
+    return std::all_of(members.begin(), members.end(), is_plain_data);
+  }
+
+  return false;
+}
+
+// Whether objects of this type are arrays of bytes, as heap objects and
+// strings are
+static bool is_byte_array(const type2tc &type)
+{
+  return is_array_type(type) && is_bv_type(to_array_type(type).subtype) &&
+         to_array_type(type).subtype->get_width() == 8;
+}
+
+// The byte at offset of object, as an unsigned char
+static expr2tc object_byte(const expr2tc &object, uint64_t offset)
+{
+  if(is_byte_array(object->type))
+    return typecast2tc(
+      get_uint8_type(),
+      index2tc(
+        to_array_type(object->type).subtype, object, gen_ulong(offset)));
+
+  assert(is_plain_data(object->type));
+  bool is_big_endian =
+    (config.ansi_c.endianess == configt::ansi_ct::IS_BIG_ENDIAN);
+  return byte_extract2tc(
+    get_uint8_type(), object, gen_ulong(offset), is_big_endian);
+}
+
+// What copying into an object assigns: either a value for the whole object,
+// or the values of its elements from first on
+struct copy_slicet
+{
+  bool whole = false;
+  uint64_t first = 0;
+  std::vector<expr2tc> values;
+};
+
+// Slices longer than this are left to the operational model
+static const uint64_t max_copy_elements = 1 << 16;
+
+// The slice of dst which copying num_of_bytes from src to it, at the given
+// offsets, assigns. False if that needs going through memory.
+static bool copy_slice(
+  const expr2tc &dst,
+  uint64_t dst_offset,
+  const expr2tc &src,
+  uint64_t src_offset,
+  uint64_t num_of_bytes,
+  copy_slicet &slice)
+{
+  const type2tc &type = dst->type;
+  uint64_t size = type_byte_size(type).to_uint64();
+
+  // The whole object
+  if(
+    dst_offset == 0 && src_offset == 0 && num_of_bytes == size &&
+    src->type == type)
+  {
+    slice.whole = true;
+    slice.values.push_back(src);
+    return true;
+  }
+
+  if(!is_array_type(type))
+    return false;
+
+  // A slice of an array with the same elements
+  const type2tc &subtype = to_array_type(type).subtype;
+  uint64_t elem_size = type_byte_size(subtype).to_uint64();
+  if(
+    is_array_type(src->type) && to_array_type(src->type).subtype == subtype &&
+    elem_size != 0 && dst_offset % elem_size == 0 &&
+    src_offset % elem_size == 0 && num_of_bytes % elem_size == 0)
+  {
+    if(num_of_bytes / elem_size > max_copy_elements)
+      return false;
+
+    slice.first = dst_offset / elem_size;
+    for(uint64_t i = 0; i < num_of_bytes / elem_size; i++)
+      slice.values.push_back(
+        index2tc(subtype, src, gen_ulong(src_offset / elem_size + i)));
+    return true;
+  }
+
+  // The bytes of anything into an array of bytes
+  if(is_byte_array(type) && is_plain_data(src->type))
+  {
+    if(num_of_bytes > max_copy_elements)
+      return false;
+
+    slice.first = dst_offset;
+    for(uint64_t i = 0; i < num_of_bytes; i++)
+      slice.values.push_back(
+        typecast2tc(subtype, object_byte(src, src_offset + i)));
+    return true;
+  }
+
+  return false;
+}
+
+// Whether any of the cases in [lo, hi) holds, and the value of the first
+// which does. Both are built as balanced trees: a chain of if-then-elses over
+// a large buffer would be as deep as the buffer is long.
+static std::pair<expr2tc, expr2tc> first_case(
+  const std::vector<std::pair<expr2tc, expr2tc>> &cases,
+  size_t lo,
+  size_t hi,
+  const type2tc &type)
+{
+  assert(lo < hi);
+  if(hi - lo == 1)
+    return cases[lo];
+
+  size_t mid = lo + (hi - lo) / 2;
+  auto [any_lo, value_lo] = first_case(cases, lo, mid, type);
+  auto [any_hi, value_hi] = first_case(cases, mid, hi, type);
+  return {or2tc(any_lo, any_hi), if2tc(type, any_lo, value_lo, value_hi)};
+}
+
+void goto_symext::intrinsic_memcpy(
+  reachability_treet &art,
+  const code_function_call2t &func_call,
+  const std::string &name)
+{
+  /**
+   * memcpy(void *dst, const void *src, size_t num_of_bytes)
+   *
+   * Like for memset, the byte loop of the operational model is replaced by
+   * one assignment per object dst may point to, and src too: the source
+   * object itself if the whole object is copied, or the destination array
+   * with a slice replaced otherwise. All values are computed before any is
+   * assigned, so overlapping objects are handled as memmove requires.
+   */
+  assert(func_call.operands.size() == 3 && "Wrong memcpy signature");
+  const execution_statet &ex_state = art.get_cur_state();
+  if(ex_state.cur_state->guard.is_false())
+    return;
+
+  const std::string impl = "c:@F@__" + name + "_impl";
+
+  expr2tc dst = func_call.operands[0];
+  expr2tc src = func_call.operands[1];
+  expr2tc size = func_call.operands[2];
+
+  cur_state->rename(size);
+  simplify(size);
+  if(!is_constant_int2t(size) || options.get_bool_option("no-simplify"))
+  {
+    log_debug("[{}] Couldn't optimize due to a symbolic size", name);
+    bump_intrinsic_call(func_call, impl);
+    return;
+  }
+
+  uint64_t num_of_bytes = to_constant_int2t(size).value.to_uint64();
+  std::list<dereference_callbackt::internal_item> dst_items, src_items;
+  if(
+    num_of_bytes != 0 &&
+    (!get_constant_targets(dst, dst_items) ||
+     !get_constant_targets(src, src_items)))
+  {
+    log_debug("[{}] Couldn't resolve the objects", name);
+    bump_intrinsic_call(func_call, impl);
+    return;
+  }
+
+  bool bounds_check = !options.get_bool_option("no-pointer-check") &&
+                      !options.get_bool_option("no-bounds-check");
+
+  struct copyt
+  {
+    expr2tc object;
+    copy_slicet slice;
+    guardt guard;
+  };
+  std::vector<copyt> copies;
+  // Only claimed once no pair falls back to the operational model
+  std::vector<std::pair<expr2tc, std::string>> bounds_claims;
+
+  for(const auto &dst_item : dst_items)
+  {
+    for(const auto &src_item : src_items)
+    {
+      guardt guard = ex_state.cur_state->guard;
+      guard.add(dst_item.guard);
+      guard.add(src_item.guard);
+
+      BigInt dst_size = constant_byte_size(dst_item.object->type);
+      BigInt src_size = constant_byte_size(src_item.object->type);
+      if(dst_size < 0 || src_size < 0 || !is_symbol2t(dst_item.object))
+      {
+        log_debug("[{}] Unsupported object", name);
+        bump_intrinsic_call(func_call, impl);
+        return;
+      }
+
+      BigInt dst_offset = to_constant_int2t(dst_item.offset).value;
+      BigInt src_offset = to_constant_int2t(src_item.offset).value;
+      if(
+        dst_offset > dst_size || dst_size - dst_offset < num_of_bytes ||
+        src_offset > src_size || src_size - src_offset < num_of_bytes)
+      {
+        if(bounds_check)
+        {
+          expr2tc false_expr = gen_false_expr();
+          guard.guard_expr(false_expr);
+          bounds_claims.emplace_back(
+            false_expr,
+            fmt::format(
+              "dereference failure: {} of {} bytes out of bounds of memory "
+              "segments of size {} and {}",
+              name,
+              num_of_bytes,
+              dst_size - dst_offset,
+              src_size - src_offset));
+        }
+        continue;
+      }
+
+      copy_slicet slice;
+      if(!copy_slice(
+           dst_item.object,
+           dst_offset.to_uint64(),
+           src_item.object,
+           src_offset.to_uint64(),
+           num_of_bytes,
+           slice))
+      {
+        log_debug("[{}] Couldn't copy between the objects", name);
+        bump_intrinsic_call(func_call, impl);
+        return;
+      }
+
+      // Pin the version of the source, which may be assigned before
+      for(expr2tc &value : slice.values)
+        cur_state->rename(value);
+      copies.push_back({dst_item.object, std::move(slice), guard});
+    }
+  }
+
+  for(const auto &[cond, msg] : bounds_claims)
+    claim(cond, msg);
+  intrinsic_valid_check(dst_items);
+  intrinsic_valid_check(src_items);
+
+  for(const copyt &copy : copies)
+  {
+    const std::vector<expr2tc> &values = copy.slice.values;
+    const type2tc &type = copy.object->type;
+    if(copy.slice.whole)
+    {
+      symex_assign(code_assign2tc(copy.object, values[0]), false, copy.guard);
+      continue;
+    }
+
+    // All elements are replaced
+    const expr2tc &array_size = to_array_type(type).array_size;
+    if(
+      copy.slice.first == 0 && !is_nil_expr(array_size) &&
+      is_constant_int2t(array_size) &&
+      to_constant_int2t(array_size).value == values.size())
+    {
+      symex_assign(
+        code_assign2tc(copy.object, constant_array2tc(type, values)),
+        false,
+        copy.guard);
+      continue;
+    }
+
+    // Otherwise in chunks, each assigned on top of the previous one, so that
+    // no chain of withs is deeper than a chunk
+    const uint64_t chunk = 64;
+    for(uint64_t begin = 0; begin < values.size(); begin += chunk)
+    {
+      expr2tc value = copy.object;
+      for(uint64_t i = begin; i < values.size() && i < begin + chunk; i++)
+        value =
+          with2tc(type, value, gen_ulong(copy.slice.first + i), values[i]);
+      symex_assign(code_assign2tc(copy.object, value), false, copy.guard);
+    }
+  }
+
+  if(num_of_bytes != 0)
+  {
+    intrinsic_null_check(dst);
+    intrinsic_null_check(src);
+  }
+
+  expr2tc ret_ref = func_call.ret;
+  if(is_nil_expr(ret_ref))
+    return;
+  dereference(ret_ref, dereferencet::READ);
+  symex_assign(code_assign2tc(ret_ref, dst), false, cur_state->guard);
+}
+
+void goto_symext::intrinsic_memcmp(
+  reachability_treet &art,
+  const code_function_call2t &func_call)
+{
+  assert(func_call.operands.size() == 3 && "Wrong memcmp signature");
+  const execution_statet &ex_state = art.get_cur_state();
+  if(ex_state.cur_state->guard.is_false())
+    return;
+
+  expr2tc s1 = func_call.operands[0];
+  expr2tc s2 = func_call.operands[1];
+  expr2tc size = func_call.operands[2];
+
+  cur_state->rename(size);
+  simplify(size);
+  if(!is_constant_int2t(size) || options.get_bool_option("no-simplify"))
+  {
+    log_debug("[memcmp] Couldn't optimize due to a symbolic size");
+    bump_intrinsic_call(func_call, "c:@F@__memcmp_impl");
+    return;
+  }
+
+  uint64_t num_of_bytes = to_constant_int2t(size).value.to_uint64();
+  std::list<dereference_callbackt::internal_item> s1_items, s2_items;
+  if(
+    num_of_bytes != 0 &&
+    (!get_constant_targets(s1, s1_items) ||
+     !get_constant_targets(s2, s2_items)))
+  {
+    log_debug("[memcmp] Couldn't resolve the objects");
+    bump_intrinsic_call(func_call, "c:@F@__memcmp_impl");
+    return;
+  }
+
+  bool bounds_check = !options.get_bool_option("no-pointer-check") &&
+                      !options.get_bool_option("no-bounds-check");
+
+  const type2tc &type = to_code_type(func_call.function->type).ret_type;
+  expr2tc result = gen_zero(type);
+  bool first = true;
+  // Only claimed once no pair falls back to the operational model
+  std::vector<std::pair<expr2tc, std::string>> bounds_claims;
+  for(const auto &s1_item : s1_items)
+  {
+    for(const auto &s2_item : s2_items)
+    {
+      BigInt s1_size = constant_byte_size(s1_item.object->type);
+      BigInt s2_size = constant_byte_size(s2_item.object->type);
+      if(
+        s1_size < 0 || s2_size < 0 ||
+        !is_plain_data(s1_item.object->type) ||
+        !is_plain_data(s2_item.object->type))
+      {
+        log_debug("[memcmp] Unsupported object");
+        bump_intrinsic_call(func_call, "c:@F@__memcmp_impl");
+        return;
+      }
+
+      expr2tc pair_guard = and2tc(s1_item.guard, s2_item.guard);
+      BigInt s1_offset = to_constant_int2t(s1_item.offset).value;
+      BigInt s2_offset = to_constant_int2t(s2_item.offset).value;
+      if(
+        s1_offset > s1_size || s1_size - s1_offset < num_of_bytes ||
+        s2_offset > s2_size || s2_size - s2_offset < num_of_bytes)
+      {
+        if(bounds_check)
+        {
+          guardt guard = ex_state.cur_state->guard;
+          guard.add(pair_guard);
+          expr2tc false_expr = gen_false_expr();
+          guard.guard_expr(false_expr);
+          bounds_claims.emplace_back(
+            false_expr,
+            fmt::format(
+              "dereference failure: memcmp of {} bytes out of bounds of "
+              "memory segments of size {} and {}",
+              num_of_bytes,
+              s1_size - s1_offset,
+              s2_size - s2_offset));
+        }
+        continue;
+      }
+
+      // The difference of the first bytes which differ, as unsigned chars.
+      // Bytes known to be equal are left out, so that comparing concrete
+      // data yields a constant.
+      std::vector<std::pair<expr2tc, expr2tc>> cases;
+      for(uint64_t i = 0; i < num_of_bytes; i++)
+      {
+        expr2tc b1 = object_byte(s1_item.object, s1_offset.to_uint64() + i);
+        expr2tc b2 = object_byte(s2_item.object, s2_offset.to_uint64() + i);
+        cur_state->rename(b1);
+        cur_state->rename(b2);
+        expr2tc differs = notequal2tc(b1, b2);
+        do_simplify(differs);
+        if(is_false(differs))
+          continue;
+
+        cases.emplace_back(
+          differs, sub2tc(type, typecast2tc(type, b1), typecast2tc(type, b2)));
+        if(is_true(differs))
+          break;
+      }
+
+      expr2tc diff = gen_zero(type);
+      if(!cases.empty())
+      {
+        auto [differs, first_diff] =
+          first_case(cases, 0, cases.size(), type);
+        diff = if2tc(type, differs, first_diff, diff);
+        do_simplify(diff);
+      }
+
+      result = first ? diff : if2tc(type, pair_guard, diff, result);
+      first = false;
+    }
+  }
+
+  for(const auto &[cond, msg] : bounds_claims)
+    claim(cond, msg);
+  intrinsic_valid_check(s1_items);
+  intrinsic_valid_check(s2_items);
+
+  if(num_of_bytes != 0)
+  {
+    intrinsic_null_check(s1);
+    intrinsic_null_check(s2);
+  }
+
+  expr2tc ret_ref = func_call.ret;
+  if(is_nil_expr(ret_ref))
+    return;
+  dereference(ret_ref, dereferencet::READ);
+  symex_assign(code_assign2tc(ret_ref, result), false, cur_state->guard);
+}
+
+void goto_symext::intrinsic_strlen(
+  reachability_treet &art,
+  const code_function_call2t &func_call)
+{
+  assert(func_call.operands.size() == 1 && "Wrong strlen signature");
+  const execution_statet &ex_state = art.get_cur_state();
+  if(ex_state.cur_state->guard.is_false())
+    return;
+
+  expr2tc s = func_call.operands[0];
+  std::list<dereference_callbackt::internal_item> items;
+  if(options.get_bool_option("no-simplify") || !get_constant_targets(s, items))
+  {
+    log_debug("[strlen] Couldn't resolve the string");
+    bump_intrinsic_call(func_call, "c:@F@__strlen_impl");
+    return;
+  }
+
+  bool bounds_check = !options.get_bool_option("no-pointer-check") &&
+                      !options.get_bool_option("no-bounds-check");
+
+  const type2tc &type = to_code_type(func_call.function->type).ret_type;
+  expr2tc result = gen_zero(type);
+  bool first = true;
+  // Only claimed once no item falls back to the operational model
+  std::vector<expr2tc> bounds_claims;
+  for(const auto &item : items)
+  {
+    BigInt size = constant_byte_size(item.object->type);
+    if(!is_byte_array(item.object->type) || size < 0)
+    {
+      log_debug("[strlen] Unsupported object");
+      bump_intrinsic_call(func_call, "c:@F@__strlen_impl");
+      return;
+    }
+
+    BigInt offset = to_constant_int2t(item.offset).value;
+    uint64_t max_len = offset < size ? (size - offset).to_uint64() : 0;
+
+    // The index of the first terminator, and whether there is one.
+    // Characters known not to be one are left out, so that concrete strings
+    // yield a constant.
+    const type2tc &subtype = to_array_type(item.object->type).subtype;
+    std::vector<std::pair<expr2tc, expr2tc>> cases;
+    for(uint64_t i = 0; i < max_len; i++)
+    {
+      expr2tc is_nul = equality2tc(
+        index2tc(subtype, item.object, gen_ulong(offset.to_uint64() + i)),
+        gen_zero(subtype));
+      cur_state->rename(is_nul);
+      do_simplify(is_nul);
+      if(is_false(is_nul))
+        continue;
+
+      cases.emplace_back(is_nul, constant_int2tc(type, BigInt(i)));
+      if(is_true(is_nul))
+        break;
+    }
+
+    expr2tc len = gen_zero(type);
+    expr2tc terminated = gen_false_expr();
+    if(!cases.empty())
+    {
+      std::tie(terminated, len) = first_case(cases, 0, cases.size(), type);
+      do_simplify(terminated);
+      do_simplify(len);
+    }
+
+    if(bounds_check)
+    {
+      guardt guard = ex_state.cur_state->guard;
+      guard.add(item.guard);
+      guard.guard_expr(terminated);
+      bounds_claims.push_back(terminated);
+    }
+
+    result = first ? len : if2tc(type, item.guard, len, result);
+    first = false;
+  }
+
+  for(const expr2tc &terminated : bounds_claims)
+    claim(terminated, "dereference failure: array bounds violated");
+  intrinsic_valid_check(items);
+  intrinsic_null_check(s);
+
+  expr2tc ret_ref = func_call.ret;
+  if(is_nil_expr(ret_ref))
+    return;
+  dereference(ret_ref, dereferencet::READ);
+  symex_assign(code_assign2tc(ret_ref, result), false, cur_state->guard);
+}
+
 void goto_symext::intrinsic_get_object_size(
   const code_function_call2t &func_call,
   reachability_treet &)
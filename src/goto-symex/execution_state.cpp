@@ -1069,31 +1069,53 @@ crypto_hash execution_statet::generate_hash() const
   auto l2 = std::dynamic_pointer_cast<state_hashing_level2t>(state_level2);
   assert(l2 != nullptr);
 
-  crypto_hash state = l2->generate_l2_state_hash();
-  std::string str = state.to_string();
-
+  std::vector<uint64_t> data;
+  data.reserve(threads_state.size() + 1);
+  data.push_back(l2->generate_l2_state_hash());
   for(const auto &it : threads_state)
-  {
-    goto_programt::const_targett pc = it.source.pc;
-    int id = pc->location_number;
-    std::stringstream s;
-    s << id;
-    str += "!" + s.str();
-  }
+    data.push_back(it.source.pc->location_number);
 
   crypto_hash h;
-  h.ingest(str.c_str(), str.size());
+  h.ingest(data.data(), data.size() * sizeof(uint64_t));
   h.fin();
 
   return h;
 }
 
-crypto_hash execution_statet::update_hash_for_assignment(const expr2tc &rhs)
+execution_statet::state_snapshott execution_statet::generate_snapshot() const
 {
-  crypto_hash h;
-  rhs->hash(h);
-  h.fin();
-  return h;
+  auto l2 = std::dynamic_pointer_cast<state_hashing_level2t>(state_level2);
+  assert(l2 != nullptr);
+
+  state_snapshott snapshot;
+  snapshot.values = l2->current_values;
+  snapshot.pcs.reserve(threads_state.size());
+  for(const auto &it : threads_state)
+    snapshot.pcs.push_back(it.source.pc->location_number);
+
+  return snapshot;
+}
+
+bool execution_statet::state_snapshott::operator==(
+  const state_snapshott &other) const
+{
+  if(pcs != other.pcs || values.size() != other.values.size())
+    return false;
+
+  // Both maps are usually copies of each other with a few modifications,
+  // only the entries which aren't shared need to be compared
+  bool equal = true;
+  values.for_each_difference(
+    other.values, [this, &equal](const auto &entry) {
+      const expr2tc *value = values.lookup(entry.first);
+      equal = equal && value && *value == entry.second;
+    });
+  return equal;
+}
+
+size_t execution_statet::update_hash_for_assignment(const expr2tc &rhs)
+{
+  return rhs->crc();
 }
 
 void execution_statet::print_stack_traces(unsigned int indent) const
@@ -1285,43 +1307,36 @@ execution_statet::state_hashing_level2t::clone() const
     new state_hashing_level2t(*this));
 }
 
+/// Contribution of \name having a value with digest \digest to the l2 hash
+static uint64_t variable_hash(const irep_idt &name, size_t digest)
+{
+  // splitmix64 finalizer, such that contributions don't cancel out
+  uint64_t h = digest ^ (uint64_t(name.get_no()) * 0x9e3779b97f4a7c15ULL);
+  h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+  return h ^ (h >> 31);
+}
+
 void execution_statet::state_hashing_level2t::make_assignment(
   expr2tc &lhs_sym,
   const expr2tc &const_value,
   const expr2tc &assigned_value)
 {
-  //  crypto_hash hash;
-
   renaming::level2t::make_assignment(lhs_sym, const_value, assigned_value);
 
   // If there's no body to the assignment, don't hash.
   if(!is_nil_expr(assigned_value))
   {
     // XXX - consider whether to use l1 names instead. Recursion, reentrancy.
-    crypto_hash hash = owner->update_hash_for_assignment(assigned_value);
-    std::string orig_name = to_symbol2t(lhs_sym).thename.as_string();
-    current_hashes[orig_name] = hash;
-  }
-}
-
-crypto_hash
-execution_statet::state_hashing_level2t::generate_l2_state_hash() const
-{
-  unsigned int total;
-  size_t hash_sz = sizeof(crypto_hash::hash);
-
-  uint8_t *data =
-    (uint8_t *)alloca(current_hashes.size() * hash_sz * sizeof(uint8_t));
-
-  total = 0;
-  for(const auto &current_hashe : current_hashes)
-  {
-    memcpy(&data[total * hash_sz], current_hashe.second.hash, hash_sz);
-    total++;
+    const irep_idt &orig_name = to_symbol2t(lhs_sym).thename;
+    auto res = current_values.emplace(orig_name, assigned_value);
+    if(!res.second)
+    {
+      state_hash ^= variable_hash(
+        orig_name, owner->update_hash_for_assignment(*res.first));
+      *res.first = assigned_value;
+    }
+    state_hash ^= variable_hash(
+      orig_name, owner->update_hash_for_assignment(assigned_value));
   }
-
-  crypto_hash c;
-  c.ingest(data, total * hash_sz);
-  c.fin();
-  return c;
 }
@@ -12,6 +12,7 @@
 #include <map>
 #include <set>
 #include <irep2/irep2.h>
+#include <util/hamt_map.h>
 #include <util/message.h>
 #include <util/std_expr.h>
 
@@ -110,6 +111,13 @@ public:
    *  State-hashing level2t.
    *  When using this level2t, any assignment made is caught, and the symbolic
    *  names are hashed. This is the primary handler for state hashing.
+   *
+   *  The hash of the l2 state is maintained incrementally, Zobrist style: it
+   *  is the XOR of one contribution per variable, mixing the variable's name
+   *  with the (cached, per node) digest of its current value. An assignment
+   *  XORs the variable's old contribution out and the new one in, so the
+   *  state hash never needs to be recomputed from all variables. The values
+   *  themselves are kept too, to tell states with the same hash apart.
    */
   class state_hashing_level2t : public ex_state_level2t
   {
@@ -121,9 +129,15 @@ public:
       expr2tc &lhs_symbol,
       const expr2tc &const_value,
       const expr2tc &assigned_value) override;
-    crypto_hash generate_l2_state_hash() const;
-    typedef std::map<irep_idt, crypto_hash> current_state_hashest;
-    current_state_hashest current_hashes;
+    uint64_t generate_l2_state_hash() const
+    {
+      return state_hash;
+    }
+    /** Value of each variable, as hashed into #state_hash. Persistent, as
+     *  every context switch copies it. */
+    typedef hamt_mapt<irep_idt, expr2tc, irep_id_hash> current_valuest;
+    current_valuest current_values;
+    uint64_t state_hash = 0;
   };
 
   // Macros
@@ -440,20 +454,42 @@ public:
 
   /**
    *  Generate hash of entire execution state.
-   *  This takes all current symbolic assignments to variables contained in the
-   *  l2 renaming object, and their precomputed hashes, concatonates them with
-   *  the current program counter of each thread, and hashes that. This results
-   *  in a full hash of the current execution state.
+   *  This takes the hash of all current symbolic assignments to variables,
+   *  maintained by the l2 renaming object, concatenates it with the current
+   *  program counter of each thread, and hashes that. This results in a full
+   *  hash of the current execution state.
    *  @return Hash of entire current execution state.
    */
   crypto_hash generate_hash() const;
 
   /**
-   *  Generate hash of an expression.
+   *  What generate_hash() digests: the value of every variable and the
+   *  program counter of every thread. The hash is only 64 bits wide before
+   *  the program counters are added, so a hash hit is confirmed by
+   *  comparing snapshots.
+   */
+  struct state_snapshott
+  {
+    state_hashing_level2t::current_valuest values;
+    std::vector<unsigned int> pcs;
+
+    bool operator==(const state_snapshott &other) const;
+  };
+
+  /**
+   *  Take a snapshot of the current execution state. This is cheap, the
+   *  values are shared with the l2 renaming object.
+   *  @return Snapshot of entire current execution state.
+   */
+  state_snapshott generate_snapshot() const;
+
+  /**
+   *  Generate hash of an expression. This is the digest irep2 caches in
+   *  every node, hence it's only computed for the new nodes of \rhs.
    *  @param rhs Expression to hash.
    *  @return Hash of passed in expression.
    */
-  crypto_hash update_hash_for_assignment(const expr2tc &rhs);
+  size_t update_hash_for_assignment(const expr2tc &rhs);
 
   /**
    *  Print stack trace of each thread to stdout.
@@ -449,6 +449,57 @@ protected:
   void intrinsic_memset(
     reachability_treet &art,
     const code_function_call2t &func_call);
+  /**
+   * @brief Intrinsic call for C memcpy and memmove function calls
+   *
+   * If the size is constant and the value set resolves both pointers to
+   * objects at constant offsets, the destination is assigned as a whole
+   * object or as an array slice. Otherwise our operational model (at
+   * string.c) is invoked.
+   *
+   * @param art
+   * @param func_call memcpy or memmove function call
+   * @param name either "memcpy" or "memmove"
+   */
+  void intrinsic_memcpy(
+    reachability_treet &art,
+    const code_function_call2t &func_call,
+    const std::string &name);
+  /**
+   * @brief Intrinsic call for C memcmp function call
+   *
+   * Compares the bytes directly when the objects are resolved as for
+   * intrinsic_memcpy, or invokes our operational model (at string.c).
+   */
+  void intrinsic_memcmp(
+    reachability_treet &art,
+    const code_function_call2t &func_call);
+  /**
+   * @brief Intrinsic call for C strlen function call
+   *
+   * Searches the terminator directly when the string is resolved to char
+   * arrays of constant size, or invokes our operational model (at string.c).
+   */
+  void intrinsic_strlen(
+    reachability_treet &art,
+    const code_function_call2t &func_call);
+  /** Executes the operational model \p impl in place of the intrinsic
+   *  \p func_call */
+  void bump_intrinsic_call(
+    const code_function_call2t &func_call,
+    const irep_idt &impl);
+  /** Claims that \p ptr, an argument of an intrinsic, isn't NULL */
+  void intrinsic_null_check(const expr2tc &ptr);
+  /** Claims that the dynamic objects among \p items, the targets of an
+   *  argument of an intrinsic, haven't been freed */
+  void intrinsic_valid_check(
+    const std::list<dereference_callbackt::internal_item> &items);
+  /** Collects the objects \p ptr points to, with their byte offsets
+   *  simplified to constants. Returns false if the value set is not exhaustive
+   *  or some offset isn't constant. */
+  bool get_constant_targets(
+    const expr2tc &ptr,
+    std::list<dereference_callbackt::internal_item> &items);
   /** Returns the size of the object
    *
    * If the object is invalid, then this function will return 0
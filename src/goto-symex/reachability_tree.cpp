@@ -107,8 +107,16 @@ bool reachability_treet::check_for_hash_collision() const
 
   crypto_hash hash;
   hash = ex_state.generate_hash();
-  if(hit_hashes.find(hash) != hit_hashes.end())
-    return true;
+  auto range = hit_hashes.equal_range(hash);
+  if(range.first == range.second)
+    return false;
+
+  // Different states can have the same hash, pruning the second one would
+  // skip interleavings which were never explored
+  execution_statet::state_snapshott snapshot = ex_state.generate_snapshot();
+  for(auto it = range.first; it != range.second; it++)
+    if(it->second == snapshot)
+      return true;
 
   return false;
 }
@@ -125,7 +133,7 @@ void reachability_treet::update_hash_collision_set()
 
   crypto_hash hash;
   hash = ex_state.generate_hash();
-  hit_hashes.insert(hash);
+  hit_hashes.emplace(hash, ex_state.generate_snapshot());
 }
 
 void reachability_treet::create_next_state()
@@ -143,9 +151,41 @@ void reachability_treet::create_next_state()
 
     new_state->switch_to_thread(next_thread_id);
     new_state->update_after_switch_point();
+
+    // Deal the subtree rooted at the new state
+    if(ileave_workers > 1 && execution_states.size() == ileave_split_depth + 1)
+    {
+      ileave_own_subtree = ileave_subtrees++ % ileave_workers == ileave_worker;
+      ileave_own_subtrees += ileave_own_subtree;
+    }
   }
 }
 
+void reachability_treet::partition_interleavings(
+  unsigned worker,
+  unsigned workers,
+  unsigned depth)
+{
+  assert(worker < workers);
+  ileave_worker = worker;
+  ileave_workers = workers;
+  ileave_split_depth = depth;
+  ileave_subtrees = 0;
+  ileave_own_subtrees = 0;
+  ileave_own_subtree = true;
+}
+
+bool reachability_treet::owns_current_formula() const
+{
+  if(ileave_workers <= 1)
+    return true;
+
+  if(execution_states.size() > ileave_split_depth)
+    return ileave_own_subtree;
+
+  return ileave_worker == 0;
+}
+
 bool reachability_treet::step_next_state()
 {
   next_thread_id = decide_ileave_direction(get_cur_state());
@@ -528,12 +568,18 @@ reachability_treet::get_next_formula()
 
   while(!is_has_complete_formula())
   {
+    // Leave the subtrees of other workers alone
+    if(!above_ileave_split() && !owns_current_formula())
+      break;
+
     while((!get_cur_state().has_cswitch_point_occured() ||
            get_cur_state().check_if_ileaves_blocked()) &&
           get_cur_state().can_execution_continue())
       get_cur_state().symex_step(*this);
 
-    if(state_hashing)
+    // States hashed in our own subtrees must not prune the part of the tree
+    // walked by all workers, or the workers would deal different subtrees
+    if(state_hashing && !above_ileave_split())
     {
       if(check_for_hash_collision())
       {
@@ -7,6 +7,7 @@
 #include <goto-symex/goto_symex.h>
 #include <goto-symex/renaming.h>
 #include <goto-symex/symex_target_equation.h>
+#include <map>
 
 #include <unordered_map>
 #include <unordered_set>
@@ -232,6 +233,40 @@ public:
    */
   bool setup_next_formula();
 
+  /**
+   *  Make this tree one of \workers which explore the interleavings together.
+   *  The subtrees rooted at depth \depth of the DFS, i.e. after \depth
+   *  context switches, are dealt round robin to the workers, in DFS order.
+   *  Every worker walks the (identical) part of the tree above that depth,
+   *  but only symexes the subtrees dealt to it. Interleavings completing
+   *  above \depth belong to worker 0.
+   *  @param worker Number of this worker, from 0 to workers - 1
+   *  @param workers Number of workers
+   *  @param depth Depth of the roots of the subtrees
+   */
+  void
+  partition_interleavings(unsigned worker, unsigned workers, unsigned depth);
+
+  /**
+   *  Whether the formula last returned by get_next_formula belongs to this
+   *  worker. If not, it is an incomplete formula that must not be solved, and
+   *  setup_next_formula moves on to the next subtree.
+   *  @return True unless the formula belongs to another worker
+   */
+  bool owns_current_formula() const;
+
+  /// Number of subtrees dealt to all the workers so far
+  unsigned int dealt_subtrees() const
+  {
+    return ileave_subtrees;
+  }
+
+  /// Number of those dealt to this worker
+  unsigned int own_subtrees() const
+  {
+    return ileave_own_subtrees;
+  }
+
   /**
    *  Class recording a reachability checkpoint.
    *  Currently likely broken; but this originally redorced a particular trace
@@ -348,13 +383,28 @@ protected:
   unsigned int next_thread_id;
   /** Whether partial-order-reduction is enabled */
   bool por;
-  /** Set of state hashes we've discovered */
-  std::set<crypto_hash> hit_hashes;
+  /** State hashes we've discovered, with the states they were taken of */
+  std::multimap<crypto_hash, execution_statet::state_snapshott> hit_hashes;
   /** Flag as to whether we're picking interleaving directions explicitly.
    *  Corresponds to the --interactive-ileaves option. */
   bool interactive_ileaves;
   /** Are we using the --schedule scheduling method? */
   bool schedule;
+  /** Interleaving partition, see partition_interleavings */
+  unsigned int ileave_worker = 0;
+  unsigned int ileave_workers = 1;
+  unsigned int ileave_split_depth = 0;
+  /** Number of subtrees dealt so far */
+  unsigned int ileave_subtrees = 0;
+  unsigned int ileave_own_subtrees = 0;
+  /** Whether the subtree being explored belongs to this worker */
+  bool ileave_own_subtree = true;
+
+  /** Whether the current state is in the part of the tree all workers walk */
+  bool above_ileave_split() const
+  {
+    return ileave_workers > 1 && execution_states.size() <= ileave_split_depth;
+  }
 
   /* Map to store the expression and thread ID,
    * which that expression belongs to. */
@@ -1,76 +1,202 @@
 #include <goto-symex/slice.h>
 
+#include <boost/functional/hash.hpp>
 #include <util/prefix.h>
+
 static bool no_slice(const symbol2t &sym)
 {
   return config.no_slice_names.count(sym.thename.as_string()) ||
-         config.no_slice_ids.count(sym.get_symbol_name());
+         (!config.no_slice_ids.empty() &&
+          config.no_slice_ids.count(sym.get_symbol_name()));
+}
+
+symex_slicet::symbol_keyt::symbol_keyt(const symbol2t &sym)
+  : name(sym.thename), level(sym.rlevel)
+{
+  switch(sym.rlevel)
+  {
+  case symbol2t::level0:
+  case symbol2t::level1_global:
+    // Both are named by their base name only
+    level = symbol2t::level0;
+    break;
+  case symbol2t::level2:
+    node_num = sym.node_num;
+    level2_num = sym.level2_num;
+    [[fallthrough]];
+  case symbol2t::level1:
+    level1_num = sym.level1_num;
+    thread_num = sym.thread_num;
+    break;
+  case symbol2t::level2_global:
+    node_num = sym.node_num;
+    level2_num = sym.level2_num;
+    break;
+  default:
+    assert(0 && "Unrecognized renaming level enum");
+    abort();
+  }
+}
+
+size_t
+symex_slicet::symbol_key_hash::operator()(const symbol_keyt &key) const
+{
+  size_t seed = 0;
+  boost::hash_combine(seed, key.name.get_no());
+  boost::hash_combine(seed, key.level);
+  boost::hash_combine(seed, key.level1_num);
+  boost::hash_combine(seed, key.thread_num);
+  boost::hash_combine(seed, key.node_num);
+  boost::hash_combine(seed, key.level2_num);
+  return seed;
 }
 
 template <bool Add>
 bool symex_slicet::get_symbols(const expr2tc &expr)
 {
+  if(!(Add ? added : queried).insert(expr.get()).second)
+    return false;
+
   bool res = false;
   // Recursively look if any of the operands has a inner symbol
   expr->foreach_operand([this, &res](const expr2tc &e) {
-    if(!is_nil_expr(e))
+    if(!is_nil_expr(e) && (Add || !res))
       res |= get_symbols<Add>(e);
     return res;
   });
 
-  if(!is_symbol2t(expr))
+  if(!is_symbol2t(expr) || (!Add && res))
     return res;
 
   const symbol2t &s = to_symbol2t(expr);
   if constexpr(Add)
-    res |= depends.insert(s.get_symbol_name()).second;
+    res |= depends.insert(symbol_keyt(s)).second;
   else
-    res |= no_slice(s) || depends.find(s.get_symbol_name()) != depends.end();
+    res |= no_slice(s) || depends.count(symbol_keyt(s));
   return res;
 }
 
+bool symex_slicet::depends_on(const expr2tc &expr)
+{
+  // Whether a node has dependencies changes as #depends does, so only
+  // remember the nodes of this query
+  if(!queried.empty())
+    queried.clear();
+  return get_symbols<false>(expr);
+}
+
+bool symex_slicet::run(
+  const symex_target_equationt::SSA_stepst &eq,
+  symex_target_equationt::ignore_maskt &mask)
+{
+  assert(mask.size() == eq.size());
+  fine_timet algorithm_start = current_time();
+  added.clear();
+  size_t i = eq.size();
+  for(const auto &step : boost::adaptors::reverse(eq))
+  {
+    --i;
+    if(slice_step(step))
+    {
+      mask.set(i);
+      ++sliced;
+    }
+  }
+  fine_timet algorithm_stop = current_time();
+  log_status(
+    "Slicing time: {}s (removed {} assignments)",
+    time2string(algorithm_stop - algorithm_start),
+    sliced);
+  return true;
+}
+
+bool symex_slicet::slice_step(const symex_target_equationt::SSA_stept &SSA_step)
+{
+  switch(SSA_step.type)
+  {
+  case goto_trace_stept::ASSIGNMENT:
+    return slice_assignment(SSA_step);
+  case goto_trace_stept::ASSUME:
+    return slice_assume(SSA_step);
+  case goto_trace_stept::ASSERT:
+    get_symbols<true>(SSA_step.guard);
+    get_symbols<true>(SSA_step.cond);
+    return false;
+  case goto_trace_stept::RENUMBER:
+    return slice_renumber(SSA_step);
+  default:
+    return false;
+  }
+}
+
 void symex_slicet::run_on_assert(symex_target_equationt::SSA_stept &SSA_step)
 {
-  get_symbols<true>(SSA_step.guard);
-  get_symbols<true>(SSA_step.cond);
+  slice_step(SSA_step);
 }
 
 void symex_slicet::run_on_assume(symex_target_equationt::SSA_stept &SSA_step)
+{
+  if(slice_assume(SSA_step))
+  {
+    SSA_step.ignore = true;
+    ++sliced;
+  }
+}
+
+void symex_slicet::run_on_assignment(
+  symex_target_equationt::SSA_stept &SSA_step)
+{
+  if(slice_assignment(SSA_step))
+  {
+    SSA_step.ignore = true;
+    ++sliced;
+  }
+}
+
+void symex_slicet::run_on_renumber(symex_target_equationt::SSA_stept &SSA_step)
+{
+  if(slice_renumber(SSA_step))
+  {
+    SSA_step.ignore = true;
+    ++sliced;
+  }
+}
+
+bool symex_slicet::slice_assume(
+  const symex_target_equationt::SSA_stept &SSA_step)
 {
   if(!slice_assumes)
   {
     get_symbols<true>(SSA_step.guard);
     get_symbols<true>(SSA_step.cond);
-    return;
+    return false;
   }
 
-  if(!get_symbols<false>(SSA_step.cond))
+  if(!depends_on(SSA_step.cond))
   {
     // we don't really need it
-    SSA_step.ignore = true;
-    ++sliced;
     if(is_symbol2t(SSA_step.cond))
       log_debug(
         "slice ignoring assume symbol {}",
         to_symbol2t(SSA_step.cond).get_symbol_name());
     else
       log_debug("slide ignoring assume expression");
+    return true;
   }
-  else
-  {
-    // If we need it, add the symbols to dependency
-    get_symbols<true>(SSA_step.guard);
-    get_symbols<true>(SSA_step.cond);
-  }
+
+  // If we need it, add the symbols to dependency
+  get_symbols<true>(SSA_step.guard);
+  get_symbols<true>(SSA_step.cond);
+  return false;
 }
 
-void symex_slicet::run_on_assignment(
-  symex_target_equationt::SSA_stept &SSA_step)
+bool symex_slicet::slice_assignment(
+  const symex_target_equationt::SSA_stept &SSA_step)
 {
   assert(is_symbol2t(SSA_step.lhs));
   // TODO: create an option to ignore nondet symbols (test case generation)
 
-  if(!get_symbols<false>(SSA_step.lhs))
+  if(!depends_on(SSA_step.lhs))
   {
     // Should we add nondet to the dependency list (mostly for test cases)?
     if(!slice_nondet)
@@ -80,43 +206,46 @@ void symex_slicet::run_on_assignment(
       {
         auto &sym = to_symbol2t(expr);
         if(has_prefix(sym.thename.as_string(), "nondet$"))
-          return;
+          return false;
       }
     }
 
     // we don't really need it
-    SSA_step.ignore = true;
-    ++sliced;
     log_debug(
       "slice ignoring assignment to symbol {}",
       to_symbol2t(SSA_step.lhs).get_symbol_name());
+    return true;
   }
-  else
-  {
-    get_symbols<true>(SSA_step.guard);
-    get_symbols<true>(SSA_step.rhs);
 
-    // Remove this symbol as we won't be seeing any references to it further
-    // into the history.
-    depends.erase(to_symbol2t(SSA_step.lhs).get_symbol_name());
-  }
+  get_symbols<true>(SSA_step.guard);
+  get_symbols<true>(SSA_step.rhs);
+
+  // Remove this symbol as we won't be seeing any references to it further
+  // into the history.
+  const symbol2t &lhs = to_symbol2t(SSA_step.lhs);
+  depends.erase(symbol_keyt(lhs));
+  // Nodes referring to an unnumbered symbol may need it again
+  if(lhs.rlevel != symbol2t::level2 && lhs.rlevel != symbol2t::level2_global)
+    added.clear();
+  return false;
 }
 
-void symex_slicet::run_on_renumber(symex_target_equationt::SSA_stept &SSA_step)
+bool symex_slicet::slice_renumber(
+  const symex_target_equationt::SSA_stept &SSA_step)
 {
   assert(is_symbol2t(SSA_step.lhs));
 
-  if(!get_symbols<false>(SSA_step.lhs))
+  if(!depends_on(SSA_step.lhs))
   {
     // we don't really need it
-    SSA_step.ignore = true;
-    ++sliced;
     log_debug(
       "slice ignoring renumbering symbol {}",
       to_symbol2t(SSA_step.lhs).get_symbol_name());
+    return true;
   }
 
   // Don't collect the symbol; this insn has no effect on dependencies.
+  return false;
 }
 
 /**
@@ -188,6 +317,42 @@ bool claim_slicer::run(symex_target_equationt::SSA_stepst &steps)
 
   return true;
 }
+
+bool claim_slicer::run(
+  const symex_target_equationt::SSA_stepst &steps,
+  symex_target_equationt::ignore_maskt &mask)
+{
+  assert(mask.size() == steps.size());
+  fine_timet algorithm_start = current_time();
+  size_t counter = 1;
+  size_t i = 0;
+  for(const auto &step : steps)
+  {
+    if(step.is_assert())
+    {
+      if(counter++ == claim_to_keep)
+      {
+        mask.reset(i);
+        claim_msg = step.comment;
+      }
+      else
+      {
+        mask.set(i);
+        ++sliced;
+      }
+    }
+    ++i;
+  }
+
+  fine_timet algorithm_stop = current_time();
+  log_status(
+    "Slicing for Claim {} ({}s)",
+    claim_msg,
+    time2string(algorithm_stop - algorithm_start));
+
+  return true;
+}
+
 // Recursively try to extract the nondet symbol of an expression
 expr2tc symex_slicet::get_nondet_symbol(const expr2tc &expr)
 {
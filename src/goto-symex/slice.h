@@ -53,6 +53,15 @@ public:
     }
   };
   bool run(symex_target_equationt::SSA_stepst &) override;
+
+  /**
+   * Same as run(), but leaves \steps untouched and records the claims to be
+   * ignored in \mask instead.
+   */
+  bool run(
+    const symex_target_equationt::SSA_stepst &steps,
+    symex_target_equationt::ignore_maskt &mask);
+
   size_t claim_to_keep;
   std::string claim_msg;
 };
@@ -86,6 +95,7 @@ public:
   bool run(symex_target_equationt::SSA_stepst &eq) override
   {
     fine_timet algorithm_start = current_time();
+    added.clear();
     for(auto &step : boost::adaptors::reverse(eq))
       run_on_step(step);
     fine_timet algorithm_stop = current_time();
@@ -96,10 +106,51 @@ public:
     return true;
   }
 
+  /**
+   * Same as run(), but leaves \eq untouched: steps which can be sliced
+   * away are recorded in \mask instead. This allows several slicers to
+   * work on a shared equation at the same time.
+   *
+   * @param eq symex formula to be sliced
+   * @param mask ignore mask of \eq, see symex_target_equationt::ignore_maskt
+   */
+  bool run(
+    const symex_target_equationt::SSA_stepst &eq,
+    symex_target_equationt::ignore_maskt &mask);
+
+  /**
+   * Identifies a renamed symbol like symbol_data::get_symbol_name() does, but
+   * without building that name: only the numbers which are part of the name
+   * at the symbol's renaming level are kept.
+   */
+  struct symbol_keyt
+  {
+    explicit symbol_keyt(const symbol2t &sym);
+
+    bool operator==(const symbol_keyt &ref) const
+    {
+      return name == ref.name && level == ref.level &&
+             level1_num == ref.level1_num && thread_num == ref.thread_num &&
+             node_num == ref.node_num && level2_num == ref.level2_num;
+    }
+
+    irep_idt name;
+    uint8_t level;
+    unsigned level1_num = 0;
+    unsigned thread_num = 0;
+    unsigned node_num = 0;
+    unsigned level2_num = 0;
+  };
+
+  struct symbol_key_hash
+  {
+    size_t operator()(const symbol_keyt &key) const;
+  };
+
   /**
    * Holds the symbols the current equation depends on.
    */
-  std::unordered_set<std::string> depends;
+  std::unordered_set<symbol_keyt, symbol_key_hash> depends;
 
   static expr2tc get_nondet_symbol(const expr2tc &expr);
 
@@ -138,12 +189,41 @@ protected:
    * If a symbol is found, then it is added into the #depends
    * member if `Add` is true, otherwise returns true.
    *
+   * Sub-expressions are shared, both within and across steps (e.g. guards),
+   * so every node is explored at most once: see #added and #queried.
+   *
    * @param expr expression to extract every symbol
    * @return true if at least one symbol was found
    */
   template <bool Add>
   bool get_symbols(const expr2tc &expr);
 
+  /// Whether \expr refers to a symbol of #depends (or one not to be sliced)
+  bool depends_on(const expr2tc &expr);
+
+  /**
+   * Nodes whose symbols were already added to #depends. This stays valid for
+   * the whole run as a level2 symbol is only removed from #depends at its
+   * unique assignment, before which it can't occur.
+   */
+  std::unordered_set<const expr2t *> added;
+
+  /// Nodes without dependencies visited by the current depends_on() query
+  std::unordered_set<const expr2t *> queried;
+
+  /**
+   * Updates the #depends with the symbols of \SSA_step and decides
+   * whether it can be sliced away. This is the non-modifying core of the
+   * run_on_* methods below.
+   *
+   * @param SSA_step any step of the formula
+   * @return true if \SSA_step should be ignored
+   */
+  bool slice_step(const symex_target_equationt::SSA_stept &SSA_step);
+  bool slice_assume(const symex_target_equationt::SSA_stept &SSA_step);
+  bool slice_assignment(const symex_target_equationt::SSA_stept &SSA_step);
+  bool slice_renumber(const symex_target_equationt::SSA_stept &SSA_step);
+
   /**
    * Remove unneeded assumes from the formula
    *
@@ -450,6 +450,22 @@ void goto_symext::run_intrinsic(
   {
     intrinsic_memset(art, func_call);
   }
+  else if(symname == "c:@F@__ESBMC_memcpy")
+  {
+    intrinsic_memcpy(art, func_call, "memcpy");
+  }
+  else if(symname == "c:@F@__ESBMC_memmove")
+  {
+    intrinsic_memcpy(art, func_call, "memmove");
+  }
+  else if(symname == "c:@F@__ESBMC_memcmp")
+  {
+    intrinsic_memcmp(art, func_call);
+  }
+  else if(symname == "c:@F@__ESBMC_strlen")
+  {
+    intrinsic_strlen(art, func_call);
+  }
   else if(symname == "c:@F@__ESBMC_get_object_size")
   {
     intrinsic_get_object_size(func_call, art);
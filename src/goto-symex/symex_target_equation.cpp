@@ -130,6 +130,30 @@ void symex_target_equationt::renumber(
     debug_print_step(SSA_step);
 }
 
+symex_target_equationt::ignore_maskt
+symex_target_equationt::get_ignore_mask() const
+{
+  ignore_maskt mask(SSA_steps.size());
+  size_t i = 0;
+  for(const auto &SSA_step : SSA_steps)
+    mask[i++] = SSA_step.ignore;
+  return mask;
+}
+
+std::shared_ptr<symex_target_equationt>
+symex_target_equationt::apply_ignore_mask(const ignore_maskt &mask) const
+{
+  assert(mask.size() == SSA_steps.size());
+  auto eq = std::make_shared<symex_target_equationt>(ns);
+
+  size_t i = 0;
+  for(const auto &SSA_step : SSA_steps)
+    if(!mask[i++])
+      eq->SSA_steps.push_back(SSA_step);
+
+  return eq;
+}
+
 void symex_target_equationt::convert(smt_convt &smt_conv)
 {
   smt_convt::ast_vec assertions;
@@ -143,6 +167,29 @@ void symex_target_equationt::convert(smt_convt &smt_conv)
       smt_conv.make_n_ary(&smt_conv, &smt_convt::mk_or, assertions));
 }
 
+void symex_target_equationt::convert_claims(
+  smt_convt &smt_conv,
+  std::vector<SSA_stepst::iterator> &claims,
+  smt_convt::ast_vec &selectors)
+{
+  smt_convt::ast_vec assertions;
+  smt_astt assumpt_ast = smt_conv.convert_ast(gen_true_expr());
+
+  for(auto it = SSA_steps.begin(); it != SSA_steps.end(); it++)
+  {
+    size_t before = assertions.size();
+    convert_internal_step(smt_conv, assumpt_ast, assertions, *it);
+    if(assertions.size() == before)
+      continue;
+
+    smt_astt sel =
+      smt_conv.mk_fresh(smt_conv.boolean_sort, "multi_property::selector");
+    smt_conv.assert_ast(smt_conv.mk_implies(sel, assertions.back()));
+    claims.push_back(it);
+    selectors.push_back(sel);
+  }
+}
+
 void symex_target_equationt::convert_internal_step(
   smt_convt &smt_conv,
   smt_astt &assumpt_ast,
@@ -506,11 +553,11 @@ tvt runtime_encoded_equationt::ask_solver_question(const expr2tc &question)
   // results are true, false, both.
   push_ctx();
   conv.assert_ast(q);
-  smt_convt::resultt res1 = conv.dec_solve();
+  smt_convt::resultt res1 = conv.dec_solve_refined();
   pop_ctx();
   push_ctx();
   conv.assert_ast(conv.invert_ast(q));
-  smt_convt::resultt res2 = conv.dec_solve();
+  smt_convt::resultt res2 = conv.dec_solve_refined();
   pop_ctx();
 
   // So; which result?
@@ -1,6 +1,7 @@
 #ifndef CPROVER_BASIC_SYMEX_EQUATION_H
 #define CPROVER_BASIC_SYMEX_EQUATION_H
 
+#include <boost/dynamic_bitset.hpp>
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
@@ -165,6 +166,33 @@ public:
   typedef std::list<SSA_stept> SSA_stepst;
   SSA_stepst SSA_steps;
 
+  /// One bit per SSA step, set if the step is to be ignored. Used to slice
+  /// a shared equation per claim without modifying (or copying) it.
+  typedef boost::dynamic_bitset<> ignore_maskt;
+
+  /// Returns a mask holding the current `ignore` flag of every step
+  ignore_maskt get_ignore_mask() const;
+
+  /**
+   * @brief Builds a new equation that only holds the steps which are not
+   * set in \mask. As ignored steps are neither encoded nor shown in traces,
+   * the result is equivalent to this equation with \mask applied.
+   */
+  std::shared_ptr<symex_target_equationt>
+  apply_ignore_mask(const ignore_maskt &mask) const;
+
+  /**
+   * Like convert(), but does not assert that some claim is violated.
+   * Instead, the violation of the i-th claim is guarded by a fresh boolean
+   * selector, which is put in \p selectors[i], and its assert step in
+   * \p claims[i]. Solving under the assumption of one selector then checks
+   * that claim alone, so that one solver can check every claim in turn.
+   */
+  void convert_claims(
+    smt_convt &smt_conv,
+    std::vector<SSA_stepst::iterator> &claims,
+    smt_convt::ast_vec &selectors);
+
   SSA_stepst::iterator get_SSA_step(unsigned s)
   {
     SSA_stepst::iterator it = SSA_steps.begin();
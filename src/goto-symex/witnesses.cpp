@@ -97,7 +97,7 @@ int generate_sha1_hash_for_file(const char *path, std::string &output)
   const int bufSize = 32768;
   char *buffer = (char *)alloca(bufSize);
 
-  crypto_hash c;
+  crypto_hash c(crypto_hash::enginet::sha1);
   int bytesRead = 0;
   while((bytesRead = fread(buffer, 1, bufSize, file)))
     c.ingest(buffer, bytesRead);
@@ -148,6 +148,49 @@ class type2t;
 class expr2t;
 class constant_array2t;
 class constant_vector2t;
+template <class T>
+class irep_container;
+
+/** Hash-consing of ireps.
+ *  When enabled, every expr/type constructed through one of the something2tc
+ *  containers (e.g. symbol2tc(...)) is looked up in a global table first. If
+ *  a structurally identical node already exists, that node is shared instead
+ *  of the freshly constructed one. Identical terms built in different places
+ *  (symex, simplifier, dereference...) then occupy a single node, keep their
+ *  cached crc, and compare equal by pointer.
+ *
+ *  The table only holds weak references, so a node nobody else shares is
+ *  still modified in place by the detach facility. It is released from the
+ *  table first, as its contents no longer match the crc it is filed under.
+ *
+ *  This is opt-in (--hash-consing); nodes created before enabling it, or via
+ *  clone(), are simply not interned.
+ */
+class irep_interningt
+{
+public:
+  static void enable(bool value);
+
+  static bool enabled() noexcept
+  {
+    return on;
+  }
+
+  static irep_container<expr2t> intern(const irep_container<expr2t> &e);
+  static irep_container<type2t> intern(const irep_container<type2t> &t);
+
+  /// Drops a node about to be modified from the table. False if another
+  /// thread has taken a reference to it meanwhile, and it must be copied.
+  static bool release(const irep_container<expr2t> &e);
+  static bool release(const irep_container<type2t> &t);
+
+  /// Number of live nodes currently in the table
+  static size_t size();
+
+private:
+  static bool on;
+};
+
 /** Reference counted container for expr2t based classes.
  *  This class extends boost shared_ptr's to contain anything that's a subclass
  *  of expr2t. It provides several ways of accessing the contained pointer;
@@ -271,8 +314,14 @@ public:
 
   void detach()
   {
-    if(this->use_count() == 1)
-      return; // No point remunging oneself if we're the only user of the ptr.
+    // No point remunging oneself if we're the only user of the ptr. Interned
+    // nodes have their crc computed, and leave the table before being changed.
+    if(
+      this->use_count() == 1 &&
+      (!irep_interningt::enabled() ||
+       std::shared_ptr<T>::get()->crc_val == 0 ||
+       irep_interningt::release(*this)))
+      return;
 
     // Assign-operate ourself into containing a fresh copy of the data. This
     // creates a new reference counted object, and assigns it to ourself,
@@ -1403,6 +1452,8 @@ public:
   template <typename... Args>
   something2tc(Args... args) : base2tc(new contained(args...))
   {
+    if(irep_interningt::enabled())
+      base2tc::operator=(irep_interningt::intern(*this));
   }
 
   typedef irep_container<base> base_container;
@@ -1444,6 +1495,9 @@ T2 *get_pointer(esbmct::something2tc<T1, T2, T3, T4, T5, T6> const &p)
 
 inline bool operator==(const type2tc &a, const type2tc &b)
 {
+  // Shared (e.g. hash-consed) nodes, or both nil
+  if(a.get() == b.get())
+    return true;
   // Handle nil ireps
   if(is_nil_type(a) && is_nil_type(b))
     return true;
@@ -1478,6 +1532,9 @@ inline bool operator>(const type2tc &a, const type2tc &b)
 
 inline bool operator==(const expr2tc &a, const expr2tc &b)
 {
+  // Shared (e.g. hash-consed) nodes, or both nil
+  if(a.get() == b.get())
+    return true;
   if(is_nil_expr(a) && is_nil_expr(b))
     return true;
   if(is_nil_expr(a) || is_nil_expr(b))
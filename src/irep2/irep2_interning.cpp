@@ -0,0 +1,161 @@
+#include <irep2/irep2.h>
+#include <irep2/irep2_expr.h>
+#include <irep2/irep2_type.h>
+#include <array>
+#include <mutex>
+#include <unordered_map>
+
+bool irep_interningt::on = false;
+
+namespace
+{
+/* The table is split in shards, selected by the node's crc, so that threads
+ * constructing ireps concurrently (e.g. --parallel-solving) rarely contend
+ * on the same lock. */
+template <class T>
+class interning_tablet
+{
+public:
+  irep_container<T> intern(const irep_container<T> &node)
+  {
+    const size_t crc = node.crc();
+    // A crc of zero reads as not computed yet, see release()
+    if(crc == 0)
+      return node;
+
+    shardt &shard = shards[crc % shards.size()];
+    std::lock_guard<std::mutex> guard(shard.lock);
+
+    auto range = shard.nodes.equal_range(crc);
+    for(auto it = range.first; it != range.second; ++it)
+    {
+      std::shared_ptr<T> other = it->second.lock();
+      if(other && *other == *node)
+        return irep_container<T>(std::move(other));
+    }
+
+    shard.nodes.emplace(crc, std::weak_ptr<T>(node));
+    if(shard.nodes.size() > shard.sweep_at)
+      sweep(shard);
+    return node;
+  }
+
+  bool release(const irep_container<T> &node)
+  {
+    shardt &shard = shards[node->crc_val % shards.size()];
+    std::lock_guard<std::mutex> guard(shard.lock);
+
+    // Another thread looked the node up since the caller checked
+    if(node.use_count() != 1)
+      return false;
+
+    auto range = shard.nodes.equal_range(node->crc_val);
+    for(auto it = range.first; it != range.second; ++it)
+    {
+      if(it->second.lock().get() == node.get())
+      {
+        shard.nodes.erase(it);
+        break;
+      }
+    }
+    return true;
+  }
+
+  size_t size()
+  {
+    size_t total = 0;
+    for(auto &shard : shards)
+    {
+      std::lock_guard<std::mutex> guard(shard.lock);
+      for(const auto &entry : shard.nodes)
+        total += !entry.second.expired();
+    }
+    return total;
+  }
+
+  void clear()
+  {
+    for(auto &shard : shards)
+    {
+      std::lock_guard<std::mutex> guard(shard.lock);
+      shard.nodes.clear();
+      shard.sweep_at = 4096;
+    }
+  }
+
+private:
+  struct shardt
+  {
+    std::mutex lock;
+    std::unordered_multimap<size_t, std::weak_ptr<T>> nodes;
+    size_t sweep_at = 4096;
+  };
+
+  std::array<shardt, 64> shards;
+
+  /* Drop the entries of the nodes that have died. */
+  static void sweep(shardt &shard)
+  {
+    for(auto it = shard.nodes.begin(); it != shard.nodes.end();)
+    {
+      if(it->second.expired())
+        it = shard.nodes.erase(it);
+      else
+        ++it;
+    }
+    shard.sweep_at = std::max<size_t>(4096, 2 * shard.nodes.size());
+  }
+};
+
+interning_tablet<expr2t> &expr_table()
+{
+  static interning_tablet<expr2t> table;
+  return table;
+}
+
+interning_tablet<type2t> &type_table()
+{
+  static interning_tablet<type2t> table;
+  return table;
+}
+} // namespace
+
+void irep_interningt::enable(bool value)
+{
+  on = value;
+  // Nodes interned so far may then be modified without being released
+  if(!on)
+  {
+    expr_table().clear();
+    type_table().clear();
+  }
+}
+
+expr2tc irep_interningt::intern(const expr2tc &e)
+{
+  if(is_nil_expr(e))
+    return e;
+  return expr_table().intern(e);
+}
+
+type2tc irep_interningt::intern(const type2tc &t)
+{
+  if(is_nil_type(t))
+    return t;
+  return type_table().intern(t);
+}
+
+size_t irep_interningt::size()
+{
+  return expr_table().size() + type_table().size();
+}
+
+bool irep_interningt::release(const expr2tc &e)
+{
+  return expr_table().release(e);
+}
+
+bool irep_interningt::release(const type2tc &t)
+{
+  return type_table().release(t);
+}
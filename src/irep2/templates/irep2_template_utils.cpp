@@ -1,4 +1,5 @@
 #include <irep2/irep2_template_utils.h>
+#include <cstring>
 std::string type_to_string(const bool &thebool, int)
 {
   return (thebool) ? "true" : "false";
@@ -447,7 +448,9 @@ size_t do_type_crc(const BigInt &theint)
   if(theint.is_zero())
     return boost::hash<uint8_t>()(0);
 
+  // dump() only writes the magnitude
   size_t crc = 0;
+  boost::hash_combine(crc, theint.is_negative());
   std::array<unsigned char, 256> buffer;
   if(theint.dump(buffer.data(), buffer.size()))
   {
@@ -456,10 +459,10 @@ size_t do_type_crc(const BigInt &theint)
   }
   else
   {
-    // bigint is too large to fit in that static buffer. This is insane; but
-    // rather than wasting time heap allocing we'll just skip recording data,
-    // at the price of possible crc collisions.
-    ;
+    // bigint is too large to fit in that static buffer, record its digits
+    std::vector<char> digits(theint.digits() + 2);
+    const char *str = theint.as_string(digits.data(), digits.size());
+    boost::hash_combine(crc, boost::hash_range(str, str + strlen(str)));
   }
   return crc;
 }
@@ -474,6 +477,10 @@ void do_type_hash(const BigInt &theint, crypto_hash &hash)
     return;
   }
 
+  // dump() only writes the magnitude
+  uint8_t negative = theint.is_negative();
+  hash.ingest(&negative, sizeof(negative));
+
   std::array<unsigned char, 256> buffer;
   if(theint.dump(buffer.data(), buffer.size()))
   {
@@ -481,10 +488,11 @@ void do_type_hash(const BigInt &theint, crypto_hash &hash)
   }
   else
   {
-    // bigint is too large to fit in that static buffer. This is insane; but
-    // rather than wasting time heap allocing we'll just skip recording data,
-    // at the price of possible crc collisions.
-    ;
+    // bigint is too large to fit in that static buffer, record its digits:
+    // hashes identify formulas across runs (--cache-asserts-file)
+    std::vector<char> digits(theint.digits() + 2);
+    const char *str = theint.as_string(digits.data(), digits.size());
+    hash.ingest(str, strlen(str));
   }
 }
 
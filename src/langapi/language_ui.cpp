@@ -5,6 +5,7 @@
 #include <util/i2string.h>
 #include <util/message.h>
 #include <util/show_symbol_table.h>
+#include <util/thread_pool.h>
 
 language_uit::language_uit(const cmdlinet &__cmdline) : _cmdline(__cmdline)
 {
@@ -12,16 +13,85 @@ language_uit::language_uit(const cmdlinet &__cmdline) : _cmdline(__cmdline)
 
 bool language_uit::parse()
 {
+  const int jobs = atoi(config.options.get_option("parse-jobs").c_str());
+  if(jobs <= 1 || _cmdline.args.size() < 2)
+  {
+    for(const auto &arg : _cmdline.args)
+    {
+      if(parse(arg))
+        return true;
+    }
+
+    return false;
+  }
+
+  // Set up the files in order, then parse those whose frontend allows it
+  // concurrently, and the others alone afterwards. Nothing but the parse
+  // trees depends on the order in which files are parsed.
+  std::vector<language_filet *> files;
   for(const auto &arg : _cmdline.args)
   {
-    if(parse(arg))
+    language_filet *lf = add_file(arg);
+    if(!lf)
       return true;
+    files.push_back(lf);
+  }
+
+  std::vector<char> failed(files.size(), false);
+  {
+    work_stealing_pool pool(jobs);
+    for(size_t i = 0; i < files.size(); i++)
+      if(files[i]->language->parse_is_thread_safe())
+        pool.submit([&files, &failed, i]() {
+          try
+          {
+            failed[i] = files[i]->language->parse(files[i]->filename);
+          }
+          catch(...)
+          {
+            failed[i] = true;
+          }
+        });
+  }
+
+  for(size_t i = 0; i < files.size(); i++)
+  {
+    if(!files[i]->language->parse_is_thread_safe())
+    {
+      config.language = language_id_by_path(files[i]->filename);
+      failed[i] = files[i]->language->parse(files[i]->filename);
+    }
+
+    if(failed[i])
+    {
+      log_error("PARSING ERROR");
+      return true;
+    }
+
+    files[i]->get_modules();
   }
 
   return false;
 }
 
 bool language_uit::parse(const std::string &filename)
+{
+  language_filet *lf = add_file(filename);
+  if(!lf)
+    return true;
+
+  if(lf->language->parse(filename))
+  {
+    log_error("PARSING ERROR");
+    return true;
+  }
+
+  lf->get_modules();
+
+  return false;
+}
+
+language_filet *language_uit::add_file(const std::string &filename)
 {
   language_idt lang = language_id_by_path(filename);
   int mode = get_mode(lang);
@@ -29,7 +99,7 @@ bool language_uit::parse(const std::string &filename)
   if(mode < 0)
   {
     log_error("failed to figure out type of file", filename);
-    return true;
+    return nullptr;
   }
 
   if(config.options.get_bool_option("old-frontend"))
@@ -38,7 +108,7 @@ bool language_uit::parse(const std::string &filename)
     if(mode == -1)
     {
       log_error("old-frontend was not built on this version of ESBMC");
-      return true;
+      return nullptr;
     }
   }
 
@@ -49,7 +119,7 @@ bool language_uit::parse(const std::string &filename)
   if(!infile)
   {
     log_error("failed to open input file", filename);
-    return true;
+    return nullptr;
   }
 
   std::pair<language_filest::filemapt::iterator, bool> result =
@@ -62,36 +132,27 @@ bool language_uit::parse(const std::string &filename)
   language_filet &lf = result.first->second;
   lf.filename = filename;
   lf.language = mode_table[mode].new_language();
-  languaget &language = *lf.language;
 
   log_progress("Parsing", filename);
 
 #ifdef ENABLE_SOLIDITY_FRONTEND
   if(mode == get_mode(language_idt::SOLIDITY))
   {
-    language.set_func_name(_cmdline.vm["function"].as<std::string>());
+    lf.language->set_func_name(_cmdline.vm["function"].as<std::string>());
 
     if(config.options.get_option("contract") == "")
     {
       log_error("Please set the smart contract source file.");
-      return true;
+      return nullptr;
     }
     else
     {
-      language.set_smart_contract_source(config.options.get_option("contract"));
+      lf.language->set_smart_contract_source(config.options.get_option("contract"));
     }
   }
 #endif
 
-  if(language.parse(filename))
-  {
-    log_error("PARSING ERROR");
-    return true;
-  }
-
-  lf.get_modules();
-
-  return false;
+  return &lf;
 }
 
 bool language_uit::typecheck()
@@ -30,6 +30,10 @@ public:
 
 protected:
   const cmdlinet &_cmdline;
+
+  /// Adds \p filename to the language files, with a new instance of its
+  /// language. Returns nullptr on error.
+  language_filet *add_file(const std::string &filename);
 };
 
 #endif
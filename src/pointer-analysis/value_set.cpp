@@ -129,37 +129,42 @@ bool value_sett::make_union(const value_sett::valuest &new_values, bool keepnew)
   bool result = false;
 
   // Iterate over all new values; if they're in the current value set, merge
-  // them. If not, only merge it in if keepnew is true.
-  for(const auto &new_value : new_values)
-  {
-    valuest::iterator it2 = values.find(new_value.first);
+  // them. If not, only merge it in if keepnew is true. Entries still shared
+  // between both sets (e.g. because they were not touched since the states
+  // forked) are skipped, merging them wouldn't change anything.
+  values.for_each_difference(
+    new_values, [this, keepnew, &result](const valuest::value_type &new_value) {
+      const entryt *e = values.lookup(new_value.first);
+
+      // If the new variable isnt in this' set,
+      if(!e)
+      {
+        // We always track these when merging value sets, as these store data
+        // that's transfered back and forth between function calls. So, the
+        // variables not existing in the state we're merging into is
+        // irrelevant.
+        if(
+          has_prefix(
+            id2string(new_value.second.identifier),
+            "value_set::dynamic_object") ||
+          new_value.second.identifier == "value_set::return_value" || keepnew)
+        {
+          values.emplace(new_value.first, new_value.second);
+          result = true;
+        }
 
-    // If the new variable isnt in this' set,
-    if(it2 == values.end())
-    {
-      // We always track these when merging value sets, as these store data
-      // that's transfered back and forth between function calls. So, the
-      // variables not existing in the state we're merging into is irrelevant.
-      if(
-        has_prefix(
-          id2string(new_value.second.identifier),
-          "value_set::dynamic_object") ||
-        new_value.second.identifier == "value_set::return_value" || keepnew)
+        return;
+      }
+
+      // The variable was in this' set, merge the values. Work on a copy so
+      // that unchanged entries stay shared.
+      object_mapt merged = e->object_map;
+      if(make_union(merged, new_value.second.object_map))
       {
-        values.insert(new_value);
+        values.lookup_mutable(new_value.first)->object_map = std::move(merged);
         result = true;
       }
-
-      continue;
-    }
-
-    // The variable was in this' set, merge the values.
-    entryt &e = it2->second;
-    const entryt &new_e = new_value.second;
-
-    if(make_union(e.object_map, new_e.object_map))
-      result = true;
-  }
+    });
 
   return result;
 }
@@ -464,11 +469,11 @@ void value_sett::get_value_set_rec(
     const std::string name = "value_set::dynamic_object" + idnum + suffix;
 
     // look it up
-    valuest::const_iterator v_it = values.find(name);
+    const entryt *e = values.lookup(name);
 
-    if(v_it != values.end())
+    if(e)
     {
-      make_union(dest, v_it->second.object_map);
+      make_union(dest, e->object_map);
       return;
     }
   }
@@ -528,12 +533,12 @@ void value_sett::get_value_set_rec(
 
     // Look up this symbol, with the given suffix to distinguish any arrays or
     // members we've picked out of it at a higher level.
-    valuest::const_iterator v_it = values.find(sym.get_symbol_name() + suffix);
+    const entryt *e = values.lookup(sym.get_symbol_name() + suffix);
 
     // If it points at things, put those things into the destination object map.
-    if(v_it != values.end())
+    if(e)
     {
-      make_union(dest, v_it->second.object_map);
+      make_union(dest, e->object_map);
       return;
     }
   }
@@ -1146,9 +1151,10 @@ void value_sett::do_free(const expr2tc &op)
     }
   }
 
-  // mark these as 'may be invalid'
-  // this, unfortunately, destroys the sharing
-  for(auto &value : values)
+  // mark these as 'may be invalid'. The value set can't be modified while
+  // iterating over it, collect the new object maps first.
+  std::vector<std::pair<irep_idt, object_mapt>> updates;
+  for(const auto &value : values)
   {
     object_mapt new_object_map;
 
@@ -1182,8 +1188,11 @@ void value_sett::do_free(const expr2tc &op)
     }
 
     if(changed)
-      value.second.object_map = new_object_map;
+      updates.emplace_back(value.first, std::move(new_object_map));
   }
+
+  for(auto &update : updates)
+    values.lookup_mutable(update.first)->object_map = std::move(update.second);
 }
 
 void value_sett::assign_rec(
@@ -4,6 +4,7 @@
 #include <pointer-analysis/value_sets.h>
 #include <set>
 #include <irep2/irep2.h>
+#include <util/hamt_map.h>
 #include <util/mp_arith.h>
 #include <util/namespace.h>
 #include <util/numbering.h>
@@ -245,8 +246,10 @@ public:
 
   /** Type of the value-set containing structure. A hash map mapping variables
    *  to an entryt, storing the value set of objects a variable might point
-   *  at. */
-  typedef std::unordered_map<irep_idt, entryt, irep_id_hash> valuest;
+   *  at. It is persistent: symex copies value sets at every fork in the
+   *  program, which only costs O(1) here, and the copies share the entries
+   *  neither of them modified. */
+  typedef hamt_mapt<irep_idt, entryt, irep_id_hash> valuest;
 
   /** Get the natural alignment unit of a reference to e. I don't know a more
    *  appropriate term, but if we were to have an offset into e, then what is
@@ -412,7 +415,7 @@ public:
    *  @return True when the erase succeeds, false otherwise. */
   bool erase(const std::string &name)
   {
-    return (values.erase(name) == 1);
+    return values.erase(name);
   }
 
   /** Get the set of things that an expression might point at. Interprets the
@@ -474,10 +477,7 @@ public:
   {
     std::string index = id2string(e.identifier) + e.suffix;
 
-    std::pair<valuest::iterator, bool> r =
-      values.insert(std::pair<irep_idt, entryt>(index, e));
-
-    return r.first->second;
+    return *values.emplace(index, e).first;
   }
 
   /** Add a value set for each variable in the given list. */
@@ -13,6 +13,11 @@ class solidity_languaget : public clang_c_languaget
 public:
   bool parse(const std::string &path) override;
 
+  bool parse_is_thread_safe() const override
+  {
+    return false;
+  }
+
   bool final(contextt &context) override;
 
   bool typecheck(contextt &context, const std::string &module) override;
@@ -28,7 +28,9 @@ bitwuzla_convt::bitwuzla_convt(const namespacet &ns, const optionst &options)
   bitw = bitwuzla_new();
   bitwuzla_set_option(bitw, BITWUZLA_OPT_PRODUCE_MODELS, 1);
   bitwuzla_set_abort_callback(bitwuzla_error_handler);
-  if(options.get_bool_option("smt-during-symex"))
+  if(
+    options.get_bool_option("smt-during-symex") ||
+    options.get_bool_option("multi-property-incremental"))
     bitwuzla_set_option(bitw, BITWUZLA_OPT_INCREMENTAL, 1);
 }
 
@@ -65,6 +67,26 @@ smt_convt::resultt bitwuzla_convt::dec_solve()
   return P_ERROR;
 }
 
+smt_convt::resultt
+bitwuzla_convt::dec_solve_assuming(const ast_vec &assumptions)
+{
+  pre_solve();
+
+  // Assumptions only last until the next call to bitwuzla_check_sat
+  for(smt_astt a : assumptions)
+    bitwuzla_assume(bitw, to_solver_smt_ast<bitw_smt_ast>(a)->a);
+
+  BitwuzlaResult result = bitwuzla_check_sat(bitw);
+
+  if(result == BITWUZLA_SAT)
+    return P_SATISFIABLE;
+
+  if(result == BITWUZLA_UNSAT)
+    return P_UNSATISFIABLE;
+
+  return P_ERROR;
+}
+
 const std::string bitwuzla_convt::solver_text()
 {
   std::string ss = "Bitwuzla ";
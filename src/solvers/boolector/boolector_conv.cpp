@@ -35,7 +35,9 @@ boolector_convt::boolector_convt(const namespacet &ns, const optionst &options)
   btor = boolector_new();
   boolector_set_opt(btor, BTOR_OPT_MODEL_GEN, 1);
   boolector_set_opt(btor, BTOR_OPT_AUTO_CLEANUP, 1);
-  if(options.get_bool_option("smt-during-symex"))
+  if(
+    options.get_bool_option("smt-during-symex") ||
+    options.get_bool_option("multi-property-incremental"))
     boolector_set_opt(btor, BTOR_OPT_INCREMENTAL, 1);
   boolector_set_abort(error_handler);
 }
@@ -73,6 +75,26 @@ smt_convt::resultt boolector_convt::dec_solve()
   return P_ERROR;
 }
 
+smt_convt::resultt
+boolector_convt::dec_solve_assuming(const ast_vec &assumptions)
+{
+  pre_solve();
+
+  // Assumptions only last until the next call to boolector_sat
+  for(smt_astt a : assumptions)
+    boolector_assume(btor, to_solver_smt_ast<btor_smt_ast>(a)->a);
+
+  int result = boolector_sat(btor);
+
+  if(result == BOOLECTOR_SAT)
+    return P_SATISFIABLE;
+
+  if(result == BOOLECTOR_UNSAT)
+    return P_UNSATISFIABLE;
+
+  return P_ERROR;
+}
+
 const std::string boolector_convt::solver_text()
 {
   std::string ss = "Boolector ";
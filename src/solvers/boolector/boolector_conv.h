@@ -29,6 +29,7 @@ public:
   void push_ctx() override;
   void pop_ctx() override;
   resultt dec_solve() override;
+  resultt dec_solve_assuming(const ast_vec &assumptions) override;
   const std::string solver_text() override;
 
   void assert_ast(smt_astt a) override;
@@ -28,6 +28,8 @@ cvc_convt::cvc_convt(const namespacet &ns, const optionst &options)
   // Already initialized stuff in the constructor list,
   smt.setOption("produce-models", true);
   smt.setOption("produce-assertions", true);
+  if(options.get_bool_option("multi-property-incremental"))
+    smt.setOption("incremental", true);
 }
 
 smt_convt::resultt cvc_convt::dec_solve()
@@ -44,6 +46,24 @@ smt_convt::resultt cvc_convt::dec_solve()
   return P_UNSATISFIABLE;
 }
 
+smt_convt::resultt cvc_convt::dec_solve_assuming(const ast_vec &assumptions)
+{
+  pre_solve();
+
+  std::vector<CVC4::Expr> assumed;
+  for(smt_astt a : assumptions)
+    assumed.push_back(to_solver_smt_ast<cvc_smt_ast>(a)->a);
+
+  CVC4::Result r = smt.checkSat(assumed);
+  if(r.isSat())
+    return P_SATISFIABLE;
+
+  if(r.isUnknown())
+    return P_ERROR;
+
+  return P_UNSATISFIABLE;
+}
+
 bool cvc_convt::get_bool(smt_astt a)
 {
   auto const *ca = to_solver_smt_ast<cvc_smt_ast>(a);
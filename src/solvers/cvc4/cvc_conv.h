@@ -19,6 +19,7 @@ public:
   ~cvc_convt() override = default;
 
   smt_convt::resultt dec_solve() override;
+  smt_convt::resultt dec_solve_assuming(const ast_vec &assumptions) override;
   const std::string solver_text() override;
 
   bool get_bool(smt_astt a) override;
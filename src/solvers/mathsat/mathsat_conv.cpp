@@ -97,6 +97,26 @@ smt_convt::resultt mathsat_convt::dec_solve()
   return smt_convt::P_ERROR;
 }
 
+smt_convt::resultt
+mathsat_convt::dec_solve_assuming(const ast_vec &assumptions)
+{
+  pre_solve();
+
+  std::vector<msat_term> assumed;
+  for(smt_astt a : assumptions)
+    assumed.push_back(to_solver_smt_ast<mathsat_smt_ast>(a)->a);
+
+  msat_result r =
+    msat_solve_with_assumptions(env, assumed.data(), assumed.size());
+  if(r == MSAT_SAT)
+    return P_SATISFIABLE;
+
+  if(r == MSAT_UNSAT)
+    return P_UNSATISFIABLE;
+
+  return smt_convt::P_ERROR;
+}
+
 bool mathsat_convt::get_bool(smt_astt a)
 {
   const mathsat_smt_ast *mast = to_solver_smt_ast<mathsat_smt_ast>(a);
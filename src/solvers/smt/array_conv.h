@@ -16,6 +16,10 @@
 //
 // As a result, this particular class is due some serious maintenence.
 
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index_container.hpp>
 #include <set>
 #include <solvers/smt/smt_conv.h>
 #include <irep2/irep2.h>
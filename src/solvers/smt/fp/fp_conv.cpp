@@ -42,7 +42,8 @@ static BigInt power2m1(std::size_t n, bool negated)
   return b;
 }
 
-fp_convt::fp_convt(smt_convt *_ctx) : ctx(_ctx)
+fp_convt::fp_convt(smt_convt *_ctx)
+  : ctx(_ctx), abstract(_ctx->options.get_bool_option("fp-refinement"))
 {
 }
 
@@ -269,6 +270,10 @@ smt_astt fp_convt::mk_smt_nearbyint_from_float(smt_astt x, smt_astt rm)
 
 smt_astt fp_convt::mk_smt_fpbv_sqrt(smt_astt x, smt_astt rm)
 {
+  const op_keyt key(fp_opt::sqrt, x, nullptr, rm);
+  if(const smt_astt *circuit = op_circuits.find(key))
+    return *circuit;
+
   unsigned ebits = x->sort->get_exponent_width();
   unsigned sbits = x->sort->get_significand_width();
 
@@ -368,7 +373,9 @@ smt_astt fp_convt::mk_smt_fpbv_sqrt(smt_astt x, smt_astt rm)
   smt_astt result = ctx->mk_ite(c4, v4, v5);
   result = ctx->mk_ite(c3, v3, result);
   result = ctx->mk_ite(c2, v2, result);
-  return ctx->mk_ite(c1, v1, result);
+  smt_astt circuit = ctx->mk_ite(c1, v1, result);
+  op_circuits.insert(key, circuit);
+  return circuit;
 }
 
 smt_astt
@@ -1250,6 +1257,13 @@ static void add_core(
 
 smt_astt fp_convt::mk_smt_fpbv_add(smt_astt x, smt_astt y, smt_astt rm)
 {
+  if(abstract)
+    return mk_abstract_op(fp_opt::add, x, y, rm);
+
+  const op_keyt key(fp_opt::add, x, y, rm);
+  if(const smt_astt *circuit = op_circuits.find(key))
+    return *circuit;
+
   assert(x->sort->get_data_width() == y->sort->get_data_width());
   assert(x->sort->get_exponent_width() == y->sort->get_exponent_width());
 
@@ -1344,7 +1358,9 @@ smt_astt fp_convt::mk_smt_fpbv_add(smt_astt x, smt_astt y, smt_astt rm)
   result = ctx->mk_ite(c4, v4, result);
   result = ctx->mk_ite(c3, v3, result);
   result = ctx->mk_ite(c2, v2, result);
-  return ctx->mk_ite(c1, v1, result);
+  smt_astt circuit = ctx->mk_ite(c1, v1, result);
+  op_circuits.insert(key, circuit);
+  return circuit;
 }
 
 smt_astt fp_convt::mk_smt_fpbv_sub(smt_astt lhs, smt_astt rhs, smt_astt rm)
@@ -1355,6 +1371,13 @@ smt_astt fp_convt::mk_smt_fpbv_sub(smt_astt lhs, smt_astt rhs, smt_astt rm)
 
 smt_astt fp_convt::mk_smt_fpbv_mul(smt_astt x, smt_astt y, smt_astt rm)
 {
+  if(abstract)
+    return mk_abstract_op(fp_opt::mul, x, y, rm);
+
+  const op_keyt key(fp_opt::mul, x, y, rm);
+  if(const smt_astt *circuit = op_circuits.find(key))
+    return *circuit;
+
   assert(x->sort->get_data_width() == y->sort->get_data_width());
   assert(x->sort->get_exponent_width() == y->sort->get_exponent_width());
 
@@ -1452,11 +1475,20 @@ smt_astt fp_convt::mk_smt_fpbv_mul(smt_astt x, smt_astt y, smt_astt rm)
   result = ctx->mk_ite(c4, v4, result);
   result = ctx->mk_ite(c3, v3, result);
   result = ctx->mk_ite(c2, v2, result);
-  return ctx->mk_ite(c1, v1, result);
+  smt_astt circuit = ctx->mk_ite(c1, v1, result);
+  op_circuits.insert(key, circuit);
+  return circuit;
 }
 
 smt_astt fp_convt::mk_smt_fpbv_div(smt_astt x, smt_astt y, smt_astt rm)
 {
+  if(abstract)
+    return mk_abstract_op(fp_opt::div, x, y, rm);
+
+  const op_keyt key(fp_opt::div, x, y, rm);
+  if(const smt_astt *circuit = op_circuits.find(key))
+    return *circuit;
+
   assert(x->sort->get_data_width() == y->sort->get_data_width());
   assert(x->sort->get_exponent_width() == y->sort->get_exponent_width());
 
@@ -1568,7 +1600,123 @@ smt_astt fp_convt::mk_smt_fpbv_div(smt_astt x, smt_astt y, smt_astt rm)
   result = ctx->mk_ite(c4, v4, result);
   result = ctx->mk_ite(c3, v3, result);
   result = ctx->mk_ite(c2, v2, result);
-  return ctx->mk_ite(c1, v1, result);
+  smt_astt circuit = ctx->mk_ite(c1, v1, result);
+  op_circuits.insert(key, circuit);
+  return circuit;
+}
+
+smt_astt fp_convt::mk_abstract_op(
+  fp_opt kind,
+  smt_astt lhs,
+  smt_astt rhs,
+  smt_astt rm)
+{
+  smt_astt result = ctx->mk_fresh(lhs->sort, "fp_conv::abstract_op");
+  abstract_ops.push_back({kind, lhs, rhs, rm, result, false, 0});
+
+  // NaN operands make a NaN
+  smt_astt is_nan = mk_smt_fpbv_is_nan(result);
+  ctx->assert_ast(ctx->mk_implies(
+    ctx->mk_or(mk_smt_fpbv_is_nan(lhs), mk_smt_fpbv_is_nan(rhs)), is_nan));
+
+  // Products and quotients have the xor of the operand signs
+  if(kind == fp_opt::mul || kind == fp_opt::div)
+    ctx->assert_ast(ctx->mk_implies(
+      ctx->mk_not(is_nan),
+      ctx->mk_eq(
+        extract_signbit(ctx, result),
+        ctx->mk_bvxor(extract_signbit(ctx, lhs), extract_signbit(ctx, rhs)))));
+
+  return result;
+}
+
+bool fp_convt::has_right_value(const abstract_opt &op)
+{
+  // ieee_floatt can't round to away
+  BigInt rm = ctx->get_bv(op.rm, false);
+  if(rm > ieee_floatt::ROUND_TO_ZERO || rm == ieee_floatt::ROUND_TO_AWAY)
+    return false;
+
+  ieee_floatt value = get_fpbv(op.lhs);
+  value.rounding_mode = (ieee_floatt::rounding_modet)rm.to_uint64();
+  switch(op.kind)
+  {
+  case fp_opt::add:
+    value += get_fpbv(op.rhs);
+    break;
+  case fp_opt::mul:
+    value *= get_fpbv(op.rhs);
+    break;
+  case fp_opt::div:
+    value /= get_fpbv(op.rhs);
+    break;
+  case fp_opt::sqrt:
+    // ieee_floatt can't tell either
+    return false;
+  }
+
+  // The circuits only make the NaN of mk_smt_fpbv_nan, the quiet one with
+  // the lowest bit set
+  BigInt expected = value.pack();
+  if(value.is_NaN())
+    expected = power2m1(value.spec.e, false) * power2(value.spec.f, false) + 1;
+
+  return ctx->get_bv(op.result, false) == expected;
+}
+
+bool fp_convt::refine()
+{
+  bool refined = false;
+  for(abstract_opt &op : abstract_ops)
+  {
+    if(op.refined || has_right_value(op))
+      continue;
+
+    abstract = false;
+    smt_astt circuit = nullptr;
+    switch(op.kind)
+    {
+    case fp_opt::add:
+      circuit = mk_smt_fpbv_add(op.lhs, op.rhs, op.rm);
+      break;
+    case fp_opt::mul:
+      circuit = mk_smt_fpbv_mul(op.lhs, op.rhs, op.rm);
+      break;
+    case fp_opt::div:
+      circuit = mk_smt_fpbv_div(op.lhs, op.rhs, op.rm);
+      break;
+    case fp_opt::sqrt:
+      circuit = mk_smt_fpbv_sqrt(op.lhs, op.rm);
+      break;
+    }
+    abstract = true;
+
+    ctx->assert_ast(ctx->mk_eq(op.result, circuit));
+    op.refined = refined = true;
+    op.refined_level = abstract_ops_sizes.size();
+  }
+
+  return refined;
+}
+
+void fp_convt::push_fp_ctx()
+{
+  abstract_ops_sizes.push_back(abstract_ops.size());
+  op_circuits.push();
+  unpack_circuits.push();
+  rm_circuits.push();
+}
+
+void fp_convt::pop_fp_ctx()
+{
+  abstract_ops.resize(abstract_ops_sizes.back());
+  abstract_ops_sizes.pop_back();
+  for(abstract_opt &op : abstract_ops)
+    if(op.refined && op.refined_level > abstract_ops_sizes.size())
+      op.refined = false;
+  op_circuits.pop();
+  unpack_circuits.pop();
+  rm_circuits.pop();
 }
 
 smt_astt fp_convt::mk_smt_fpbv_eq(smt_astt lhs, smt_astt rhs)
@@ -1769,6 +1917,15 @@ void fp_convt::unpack(
   smt_astt &lz,
   bool normalize)
 {
+  if(auto parts = unpack_circuits.find({src, normalize}))
+  {
+    sgn = (*parts)[0];
+    sig = (*parts)[1];
+    exp = (*parts)[2];
+    lz = (*parts)[3];
+    return;
+  }
+
   unsigned sbits = src->sort->get_significand_width();
   unsigned ebits = src->sort->get_exponent_width();
 
@@ -1830,6 +1987,8 @@ void fp_convt::unpack(
   assert(sgn->sort->get_data_width() == 1);
   assert(sig->sort->get_data_width() == sbits);
   assert(exp->sort->get_data_width() == ebits);
+
+  unpack_circuits.insert({src, normalize}, {sgn, sig, exp, lz});
 }
 
 smt_astt fp_convt::mk_unbias(smt_astt &src)
@@ -2122,6 +2281,9 @@ smt_astt fp_convt::mk_rounding_decision(
 
 smt_astt fp_convt::mk_is_rm(smt_astt &rme, ieee_floatt::rounding_modet rm)
 {
+  if(const smt_astt *is_rm = rm_circuits.find({rme, rm}))
+    return *is_rm;
+
   smt_astt rm_num = ctx->mk_smt_bv(rm, 3);
   switch(rm)
   {
@@ -2130,7 +2292,11 @@ smt_astt fp_convt::mk_is_rm(smt_astt &rme, ieee_floatt::rounding_modet rm)
   case ieee_floatt::ROUND_TO_PLUS_INF:
   case ieee_floatt::ROUND_TO_MINUS_INF:
   case ieee_floatt::ROUND_TO_ZERO:
-    return ctx->mk_eq(rme, rm_num);
+  {
+    smt_astt is_rm = ctx->mk_eq(rme, rm_num);
+    rm_circuits.insert({rme, rm}, is_rm);
+    return is_rm;
+  }
   default:
     break;
   }
@@ -3,6 +3,49 @@
 
 #include <solvers/smt/smt_ast.h>
 #include <solvers/smt/smt_sort.h>
+#include <array>
+#include <map>
+#include <tuple>
+#include <vector>
+
+/// Memoized sub-circuits, from their inputs to their outputs. Entries are
+/// dropped when the solver context they were made in is popped, as their
+/// ASTs are deleted then.
+template <typename Key, typename Value>
+class fp_circuit_cachet
+{
+public:
+  const Value *find(const Key &key) const
+  {
+    auto it = circuits.find(key);
+    return it == circuits.end() ? nullptr : &it->second;
+  }
+
+  void insert(const Key &key, const Value &value)
+  {
+    if(circuits.emplace(key, value).second)
+      keys.push_back(key);
+  }
+
+  void push()
+  {
+    sizes.push_back(keys.size());
+  }
+
+  void pop()
+  {
+    for(; keys.size() > sizes.back(); keys.pop_back())
+      circuits.erase(keys.back());
+    sizes.pop_back();
+  }
+
+private:
+  std::map<Key, Value> circuits;
+  /// In insertion order
+  std::vector<Key> keys;
+  /// Number of keys at each push
+  std::vector<size_t> sizes;
+};
 
 class fp_convt
 {
@@ -219,9 +262,66 @@ public:
    */
   virtual smt_astt mk_from_fp_to_bv(smt_astt op);
 
+  /** With --fp-refinement, additions, subtractions, multiplications and
+   *  divisions are first encoded as fresh values, constrained by a few cheap
+   *  lemmas only. This evaluates them with ieee_floatt on the model of the
+   *  last satisfiable check, and bit-blasts the ones whose value is wrong.
+   *  @return Whether any operation was bit-blasted. */
+  virtual bool refine();
+
+  virtual void push_fp_ctx();
+  virtual void pop_fp_ctx();
+
 private:
   smt_convt *ctx;
 
+  enum class fp_opt
+  {
+    add,
+    mul,
+    div,
+    sqrt
+  };
+
+  /// An operation encoded as a fresh value, until refined
+  struct abstract_opt
+  {
+    fp_opt kind;
+    smt_astt lhs;
+    smt_astt rhs;
+    smt_astt rm;
+    smt_astt result;
+    bool refined;
+    /// The context level the refinement lemma was asserted at. Popping it
+    /// retracts the lemma, and the operation is abstract again.
+    size_t refined_level;
+  };
+
+  /// Whether to abstract operations, see refine()
+  bool abstract;
+  /// The operations made in a context are dropped when it is popped, as
+  /// their ASTs are deleted
+  std::vector<abstract_opt> abstract_ops;
+  /// Number of abstract_ops at each push
+  std::vector<size_t> abstract_ops_sizes;
+
+  /// Identical operations on the same ASTs share their circuit. So do the
+  /// unpacking of an operand (with the leading zeros of its significand),
+  /// and the tests of the rounding mode (usually a single AST for the whole
+  /// formula).
+  typedef std::tuple<fp_opt, smt_astt, smt_astt, smt_astt> op_keyt;
+  fp_circuit_cachet<op_keyt, smt_astt> op_circuits;
+  fp_circuit_cachet<std::pair<smt_astt, bool>, std::array<smt_astt, 4>>
+    unpack_circuits;
+  fp_circuit_cachet<std::pair<smt_astt, int>, smt_astt> rm_circuits;
+
+  smt_astt mk_abstract_op(
+    fp_opt kind,
+    smt_astt lhs,
+    smt_astt rhs,
+    smt_astt rm);
+  bool has_right_value(const abstract_opt &op);
+
   void unpack(
     smt_astt &src,
     smt_astt &sgn,
@@ -0,0 +1,120 @@
+#ifndef _ESBMC_SOLVERS_SMT_SMT_CACHE_H_
+#define _ESBMC_SOLVERS_SMT_SMT_CACHE_H_
+
+#include <cstdint>
+#include <irep2/irep2.h>
+#include <solvers/smt/smt_ast.h>
+#include <vector>
+
+/**
+ * Cache of the ASTs expressions were converted to, scoped by solver
+ * context level.
+ *
+ * The entries are stored in a vector in insertion order and found through
+ * an open addressing (linear probing) table of indices into that vector.
+ * Expressions are hashed by their cached crc, and compared with operator==,
+ * which only compares them structurally if they aren't the same node.
+ *
+ * Entries are inserted at the current context level, which never decreases
+ * between pops, so the entries of the innermost level are always the last
+ * ones: the vector is its own undo log. Removing them in reverse order just
+ * empties their slots, as the table then looks like they were never
+ * inserted. Growing the table re-inserts the entries in order too, so that
+ * this stays true.
+ */
+class smt_cachet
+{
+public:
+  /// The AST \p expr was converted to, or nullptr
+  smt_astt find(const expr2tc &expr) const
+  {
+    if(table.empty())
+      return nullptr;
+
+    const size_t hash = expr.crc();
+    for(size_t slot = hash & mask();; slot = (slot + 1) & mask())
+    {
+      uint32_t idx = table[slot];
+      if(idx == empty_slot)
+        return nullptr;
+      const entryt &e = entries[idx];
+      if(e.hash == hash && e.val == expr)
+        return e.ast;
+    }
+  }
+
+  /// Records \p ast for \p expr at context level \p level, unless \p expr
+  /// is cached already
+  void insert(const expr2tc &expr, smt_astt ast, unsigned int level)
+  {
+    assert(entries.empty() || entries.back().level <= level);
+    if((entries.size() + 1) * 4 > table.size() * 3)
+      grow();
+
+    const size_t hash = expr.crc();
+    size_t slot = hash & mask();
+    for(; table[slot] != empty_slot; slot = (slot + 1) & mask())
+    {
+      const entryt &e = entries[table[slot]];
+      if(e.hash == hash && e.val == expr)
+        return;
+    }
+
+    table[slot] = entries.size();
+    entries.push_back({expr, ast, hash, level});
+  }
+
+  /// Removes the entries of the levels above \p level
+  void pop_to(unsigned int level)
+  {
+    while(!entries.empty() && entries.back().level > level)
+    {
+      const entryt &e = entries.back();
+      const uint32_t idx = entries.size() - 1;
+      size_t slot = e.hash & mask();
+      while(table[slot] != idx)
+        slot = (slot + 1) & mask();
+      table[slot] = empty_slot;
+      entries.pop_back();
+    }
+  }
+
+  size_t size() const
+  {
+    return entries.size();
+  }
+
+private:
+  struct entryt
+  {
+    expr2tc val;
+    smt_astt ast;
+    size_t hash;
+    unsigned int level;
+  };
+
+  static constexpr uint32_t empty_slot = UINT32_MAX;
+
+  std::vector<entryt> entries;
+  /// Size is zero or a power of two
+  std::vector<uint32_t> table;
+
+  size_t mask() const
+  {
+    return table.size() - 1;
+  }
+
+  void grow()
+  {
+    table.assign(table.empty() ? 64 : table.size() * 2, empty_slot);
+    for(uint32_t idx = 0; idx < entries.size(); idx++)
+    {
+      size_t slot = entries[idx].hash & mask();
+      while(table[slot] != empty_slot)
+        slot = (slot + 1) & mask();
+      table[slot] = idx;
+    }
+  }
+};
+
+#endif
@@ -159,6 +159,7 @@ void smt_convt::push_ctx()
 {
   tuple_api->push_tuple_ctx();
   array_api->push_array_ctx();
+  fp_api->push_fp_ctx();
 
   addr_space_data.push_back(addr_space_data.back());
   addr_space_sym_num.push_back(addr_space_sym_num.back());
@@ -174,8 +175,7 @@ void smt_convt::pop_ctx()
 {
   // Erase everything in caches added in the current context level. Everything
   // before the push is going to disappear.
-  smt_cachet::nth_index<1>::type &cache_numindex = smt_cache.get<1>();
-  cache_numindex.erase(ctx_level);
+  smt_cache.pop_to(ctx_level - 1);
   pointer_logic.pop_back();
   addr_space_sym_num.pop_back();
   addr_space_data.pop_back();
@@ -192,6 +192,7 @@ void smt_convt::pop_ctx()
   live_asts.resize(live_asts_sizes.back());
   live_asts_sizes.pop_back();
 
+  fp_api->pop_fp_ctx();
   array_api->pop_array_ctx();
   tuple_api->pop_tuple_ctx();
 }
@@ -227,17 +228,91 @@ smt_astt smt_convt::convert_assign(const expr2tc &expr)
   // IMPORTANT: the cache is now a fundamental part of how some flatteners work,
   // in that one can choose to create a set of expressions and their ASTs, then
   // store them in the cache, rather than have a more sophisticated conversion.
-  smt_cache_entryt e = {eq.side_1, side2, ctx_level};
-  smt_cache.insert(e);
+  smt_cache.insert(eq.side_1, side2, ctx_level);
 
   return side2;
 }
 
+/** Collects the operands of \expr which convert_ast converts just as they
+ *  are, before converting \expr itself */
+static void
+convertible_operands(const expr2tc &expr, std::vector<const expr2tc *> &ops)
+{
+  // Vectors operations are rewritten first
+  if(is_vector_type(expr))
+    return;
+
+  switch(expr->expr_id)
+  {
+  case expr2t::with_id:
+    if(!is_union_type(expr))
+      ops.push_back(&to_with2t(expr).source_value);
+    break;
+
+  case expr2t::index_id:
+    ops.push_back(&to_index2t(expr).source_value);
+    break;
+
+  case expr2t::constant_array_id:
+  case expr2t::constant_vector_id:
+  case expr2t::constant_array_of_id:
+  case expr2t::address_of_id:
+  case expr2t::ieee_add_id:
+  case expr2t::ieee_sub_id:
+  case expr2t::ieee_mul_id:
+  case expr2t::ieee_div_id:
+  case expr2t::ieee_fma_id:
+  case expr2t::ieee_sqrt_id:
+    break;
+
+  default:
+    expr->foreach_operand([&ops](const expr2tc &e) { ops.push_back(&e); });
+  }
+}
+
 smt_astt smt_convt::convert_ast(const expr2tc &expr)
 {
-  smt_cachet::const_iterator cache_result = smt_cache.find(expr);
-  if(cache_result != smt_cache.end())
-    return (cache_result->ast);
+  if(smt_astt a = smt_cache.find(expr))
+    return a;
+
+  // Convert the operands first, deepest first, with an explicit stack rather
+  // than by recursion: deep SSA chains (e.g. long sequences of array updates)
+  // would overflow the native one. Then converting each node only needs its
+  // operands from the cache.
+  std::vector<std::pair<const expr2tc *, bool>> stack = {{&expr, false}};
+  std::vector<const expr2tc *> ops;
+  while(true)
+  {
+    auto &[e, expanded] = stack.back();
+    if(expanded)
+    {
+      if(stack.size() == 1)
+        break;
+      if(!smt_cache.find(*e))
+        convert_ast_node(*e);
+      stack.pop_back();
+      continue;
+    }
+
+    if(stack.size() > 1 && smt_cache.find(*e))
+    {
+      stack.pop_back();
+      continue;
+    }
+
+    expanded = true;
+    ops.clear();
+    convertible_operands(*e, ops);
+    for(const expr2tc *op : ops)
+      if(!is_nil_expr(*op) && !is_vector_type(*op))
+        stack.emplace_back(op, false);
+  }
+
+  return convert_ast_node(expr);
+}
+
+smt_astt smt_convt::convert_ast_node(const expr2tc &expr)
+{
 
   /* Vectors!
    *
@@ -1166,8 +1241,7 @@ smt_astt smt_convt::convert_ast(const expr2tc &expr)
     abort();
   }
 
-  struct smt_cache_entryt entry = {expr, a, ctx_level};
-  smt_cache.insert(entry);
+  smt_cache.insert(expr, a, ctx_level);
 
   return a;
 }
@@ -2114,6 +2188,29 @@ type2tc smt_convt::get_flattened_array_subtype(const type2tc &type)
   return type_rec;
 }
 
+smt_convt::resultt smt_convt::dec_solve_assuming(const ast_vec &)
+{
+  log_error("{} does not support solving under assumptions", solver_text());
+  return P_ERROR;
+}
+
+smt_convt::resultt smt_convt::dec_solve_refined()
+{
+  resultt res = dec_solve();
+  while(res == P_SATISFIABLE && fp_api->refine())
+    res = dec_solve();
+  return res;
+}
+
+smt_convt::resultt smt_convt::dec_solve_refined(const ast_vec &assumptions)
+{
+  // The refinement lemmas hold whatever the assumptions are
+  resultt res = dec_solve_assuming(assumptions);
+  while(res == P_SATISFIABLE && fp_api->refine())
+    res = dec_solve_assuming(assumptions);
+  return res;
+}
+
 void smt_convt::pre_solve()
 {
   // NB: always perform tuple constraint adding first, as it covers tuple
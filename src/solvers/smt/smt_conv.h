@@ -1,13 +1,10 @@
 #ifndef _ESBMC_PROP_SMT_SMT_CONV_H_
 #define _ESBMC_PROP_SMT_SMT_CONV_H_
 
-#include <boost/multi_index/hashed_index.hpp>
-#include <boost/multi_index/member.hpp>
-#include <boost/multi_index/ordered_index.hpp>
-#include <boost/multi_index_container.hpp>
 #include <cstdint>
 #include <solvers/prop/literal.h>
 #include <solvers/prop/pointer_logic.h>
+#include <solvers/smt/smt_cache.h>
 #include <irep2/irep2_utils.h>
 #include <util/message.h>
 #include <util/namespace.h>
@@ -189,6 +186,10 @@ public:
    *  @return The resulting handle to the SMT value. */
   smt_astt convert_ast(const expr2tc &expr);
 
+  /** Converts expr itself, after convert_ast cached the operands it converts
+   *  unchanged. Anything else is still converted through convert_ast. */
+  smt_astt convert_ast_node(const expr2tc &expr);
+
   /** Interface to specifig SMT conversion.
    *  Takes one expression, and converts it into the underlying SMT solver,
    *  depending on the type of the expression.
@@ -249,6 +250,24 @@ public:
    *  @return Result code of the call to the solver. */
   virtual resultt dec_solve() = 0;
 
+  /** Like dec_solve, but the given boolean formulae only have to be true
+   *  for this call: they aren't asserted. Solvers keep whatever they learnt
+   *  between calls, which makes checking many similar queries cheap. The
+   *  default implementation is an error; solvers which support solving under
+   *  assumptions override it.
+   *  @param assumptions Boolean ASTs, typically fresh symbols.
+   *  @return Result code of the call to the solver. */
+  virtual resultt dec_solve_assuming(const ast_vec &assumptions);
+
+  /** Calls dec_solve until the model agrees with the floating-point
+   *  operations which fp_api abstracted (see fp_convt::refine), refining
+   *  those it gets wrong in between.
+   *  @return Result code of the last call to the solver. */
+  resultt dec_solve_refined();
+
+  /** dec_solve_refined, under assumptions (see dec_solve_assuming). */
+  resultt dec_solve_refined(const ast_vec &assumptions);
+
   void pre_solve();
 
   /** Get the satisfying assignment using the type.
@@ -769,25 +788,6 @@ public:
 
   // Types
 
-  // Type for (optional) AST cache
-
-  struct smt_cache_entryt
-  {
-    const expr2tc val;
-    smt_astt ast;
-    unsigned int level;
-  };
-
-  typedef boost::multi_index_container<
-    smt_cache_entryt,
-    boost::multi_index::indexed_by<
-      boost::multi_index::hashed_unique<
-        BOOST_MULTI_INDEX_MEMBER(smt_cache_entryt, const expr2tc, val)>,
-      boost::multi_index::ordered_non_unique<
-        BOOST_MULTI_INDEX_MEMBER(smt_cache_entryt, unsigned int, level),
-        std::greater<unsigned int>>>>
-    smt_cachet;
-
   typedef std::unordered_map<type2tc, smt_sortt, type2_hash> smt_sort_cachet;
 
   // Members
@@ -262,9 +262,8 @@ smt_astt smt_convt::convert_identifier_pointer(
   // expression this is sourced from might have ended up with the wrong type,
   // alas.
   address_of2tc new_addr_of(expr->type, expr);
-  smt_cachet::const_iterator cache_result = smt_cache.find(new_addr_of);
-  if(cache_result != smt_cache.end())
-    return (cache_result->ast);
+  if(smt_astt cached = smt_cache.find(new_addr_of))
+    return cached;
 
   // Has this been touched by realloc / been re-numbered?
   renumber_mapt::iterator it = renumber_map.back().find(symbol);
@@ -323,8 +322,7 @@ smt_astt smt_convt::convert_identifier_pointer(
   }
 
   // Insert canonical address-of this expression.
-  struct smt_cache_entryt entry = {new_addr_of, a, ctx_level};
-  smt_cache.insert(entry);
+  smt_cache.insert(new_addr_of, a, ctx_level);
 
   return a;
 }
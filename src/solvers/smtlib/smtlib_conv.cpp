@@ -6,10 +6,13 @@
 #include <smtlib_tok.hpp>
 
 #include <cinttypes>
+#include <mutex>
 #include <regex>
 #include <sstream>
+#include <unordered_map>
 
 #ifndef _WIN32
+#include <fcntl.h>
 #include <unistd.h>
 #include <signal.h>
 #endif
@@ -185,12 +188,20 @@ smtlib_convt::file_emitter::~file_emitter() noexcept
     fclose(out_stream);
 }
 
+#ifndef _WIN32
+/* Writing to a solver which died must not kill us, so SIGPIPE is ignored
+ * while there are sessions. */
+static std::mutex sigpipe_mutex;
+static unsigned int sigpipe_users = 0;
+static void (*org_sigpipe_handler)(int);
+#endif
+
 smtlib_convt::process_emitter::process_emitter(const std::string &cmd)
-  : out_stream(nullptr), in_stream(nullptr), org_sigpipe_handler(nullptr)
+  : out_fd(-1),
+    in_stream(nullptr),
+    owner_pid(0),
+    broken(false)
 {
-  if(cmd == "")
-    return;
-
   // Setup: open a pipe to the smtlib solver. There seems to be no standard C++
   // way of opening a stream from an fd, so use C file streams.
 
@@ -242,28 +253,33 @@ smtlib_convt::process_emitter::process_emitter(const std::string &cmd)
   {
     close(outpipe[0]);
     close(inpipe[1]);
-    out_stream = fdopen(outpipe[1], "w");
+    // Solvers forked later must not inherit our ends of the pipes, or this
+    // solver would never see EOF on its input while they live.
+    fcntl(outpipe[1], F_SETFD, FD_CLOEXEC);
+    fcntl(inpipe[0], F_SETFD, FD_CLOEXEC);
+    out_fd = outpipe[1];
     in_stream = fdopen(inpipe[0], "r");
+    owner_pid = getpid();
 
-    org_sigpipe_handler = reinterpret_cast<void *>(signal(SIGPIPE, SIG_IGN));
-    if(org_sigpipe_handler == SIG_ERR)
+    std::lock_guard lock(sigpipe_mutex);
+    if(sigpipe_users++ == 0)
     {
-      log_error("registering SIGPIPE handler: {}", strerror(errno));
-      abort();
+      org_sigpipe_handler = signal(SIGPIPE, SIG_IGN);
+      if(org_sigpipe_handler == SIG_ERR)
+      {
+        log_error("registering SIGPIPE handler: {}", strerror(errno));
+        abort();
+      }
     }
   }
   // Execution continues as the parent ESBMC process. Child dying will
   // trigger SIGPIPE or an EOF eventually, which we'll be able to detect
   // and crash upon.
 
-  // Point lexer input at output stream
-  smtlib_tokin = in_stream;
-
   // Fetch solver name and version.
   emit("%s", "(get-info :name)\n");
   flush();
-  smtlib_send_start_code = 1;
-  smtlibparse(TOK_START_INFO);
+  parse(TOK_START_INFO);
 
   // As a result we should have a single entry in a list of sexprs.
   class sexpr *sexpr = smtlib_output;
@@ -289,8 +305,7 @@ smtlib_convt::process_emitter::process_emitter(const std::string &cmd)
   // Duplicate / boilerplate;
   emit("%s", "(get-info :version)\n");
   flush();
-  smtlib_send_start_code = 1;
-  smtlibparse(TOK_START_INFO);
+  parse(TOK_START_INFO);
 
   sexpr = smtlib_output;
   assert(
@@ -322,34 +337,125 @@ smtlib_convt::process_emitter::process_emitter(const std::string &cmd)
 
 smtlib_convt::process_emitter::~process_emitter() noexcept
 {
-  if(out_stream)
-    fclose(out_stream);
-  if(in_stream)
-    fclose(in_stream);
 #ifndef _WIN32
-  if(org_sigpipe_handler)
-    signal(SIGPIPE, reinterpret_cast<void (*)(int)>(org_sigpipe_handler));
+  if(out_fd == -1)
+    return;
+
+  close(out_fd);
+  fclose(in_stream);
+
+  std::lock_guard lock(sigpipe_mutex);
+  if(--sigpipe_users == 0)
+    signal(SIGPIPE, org_sigpipe_handler);
 #endif
 }
 
+/* Sessions with external solvers which are not used by any smtlib_convt at
+ * the moment, keyed by the solver command and the logic they were set up
+ * for. They are closed, and the solvers see EOF, when ESBMC exits. */
+static std::mutex session_pool_mutex;
+static std::unordered_multimap<
+  std::string,
+  std::unique_ptr<smtlib_convt::process_emitter>>
+  session_pool;
+
+static std::unique_ptr<smtlib_convt::process_emitter>
+take_session(const std::string &key)
+{
+  std::lock_guard lock(session_pool_mutex);
+  auto it = session_pool.find(key);
+  if(it == session_pool.end())
+    return nullptr;
+
+  std::unique_ptr<smtlib_convt::process_emitter> session =
+    std::move(it->second);
+  session_pool.erase(it);
+#ifndef _WIN32
+  // The pipes of sessions inherited from a parent ESBMC process are still
+  // used by the parent.
+  if(session->owner_pid != getpid())
+    return nullptr;
+#endif
+  return session;
+}
+
+static void give_session(
+  const std::string &key,
+  std::unique_ptr<smtlib_convt::process_emitter> session,
+  unsigned int levels)
+{
+  if(session->broken)
+    return;
+
+  // Drop everything the previous user declared and asserted
+  try
+  {
+    session->emit("(pop %u)\n", levels);
+    session->flush();
+  }
+  catch(const smtlib_convt::external_process_died &)
+  {
+    return;
+  }
+
+  std::lock_guard lock(session_pool_mutex);
+  session_pool.emplace(key, std::move(session));
+}
+
 smtlib_convt::smtlib_convt(const namespacet &_ns, const optionst &_options)
   : smt_convt(_ns, _options),
     array_iface(false, false),
     fp_convt(this),
-    emit_proc(_options.get_option("smtlib-solver-prog")),
     emit_opt_output(_options.get_option("output"))
 {
   std::string logic =
     options.get_bool_option("int-encoding") ? "QF_AUFLIRA" : "QF_AUFBV";
 
-  emit("%s", "(set-option :produce-models true)\n");
-  emit("(set-logic %s)\n", logic.c_str());
-  emit("%s", "(set-info :status unknown)\n");
+  auto preamble = [&logic](const auto &out) {
+    out.emit("%s", "(set-option :produce-models true)\n");
+    out.emit("(set-logic %s)\n", logic.c_str());
+    out.emit("%s", "(set-info :status unknown)\n");
+  };
+
+  if(emit_opt_output)
+    preamble(emit_opt_output);
+
+  std::string cmd = options.get_option("smtlib-solver-prog");
+  if(cmd == "")
+    return;
+
+  // Our formula lives in its own scope, which is popped when the session is
+  // given back. Sessions whose solver died since are dropped.
+  session_key = cmd + "\n" + logic;
+  while((emit_proc = take_session(session_key)))
+  {
+    try
+    {
+      emit_proc->emit("%s", "(push 1)\n");
+      emit_proc->flush();
+      log_debug(
+        "Reusing external solver '{}' version '{}'",
+        emit_proc->solver_name,
+        emit_proc->solver_version);
+      return;
+    }
+    catch(const external_process_died &)
+    {
+      log_debug("External solver '{}' has died", emit_proc->solver_name);
+    }
+  }
+
+  emit_proc = std::make_unique<process_emitter>(cmd);
+  preamble(*emit_proc);
+  emit_proc->emit("%s", "(push 1)\n");
 }
 
 smtlib_convt::~smtlib_convt()
 {
   delete_all_asts();
+
+  if(emit_proc)
+    give_session(session_key, std::move(emit_proc), ctx_level + 1);
 }
 
 std::string smtlib_convt::sort_to_string(const smt_sort *s) const
@@ -542,14 +648,14 @@ void smtlib_smt_ast::dump() const
    * and we're restoring its state at the end of this function. */
   smtlib_convt *ctx_m = const_cast<smtlib_convt *>(ctx);
   FILE *tmp_file = std::exchange(ctx_m->emit_opt_output.out_stream, stderr);
-  FILE *tmp_proc = std::exchange(ctx_m->emit_proc.out_stream, nullptr);
+  auto tmp_proc = std::move(ctx_m->emit_proc);
 
   ctx->emit_ast(this);
   ctx->emit("%s", "\n");
   ctx->flush();
 
   ctx_m->emit_opt_output.out_stream = tmp_file;
-  ctx_m->emit_proc.out_stream = tmp_proc;
+  ctx_m->emit_proc = std::move(tmp_proc);
 }
 
 smt_convt::resultt smtlib_convt::dec_solve()
@@ -570,29 +676,68 @@ smt_convt::resultt smtlib_convt::dec_solve()
   if(!emit_proc)
     return smt_convt::P_SMTLIB;
 
-  // And read in the output
-  smtlib_send_start_code = 1;
-  smtlibparse(TOK_START_SAT);
+  return read_check_sat();
+}
 
-  // This should generate on sexpr. See what it is.
-  if(smtlib_output->token == TOK_KW_SAT)
-  {
-    return smt_convt::P_SATISFIABLE;
-  }
-  if(smtlib_output->token == TOK_KW_UNSAT)
+smt_convt::resultt
+smtlib_convt::dec_solve_assuming(const ast_vec &assumptions)
+{
+  pre_solve();
+
+  // check-sat-assuming only takes Boolean literals, name anything else.
+  std::string lits;
+  for(smt_astt a : assumptions)
   {
-    return smt_convt::P_UNSATISFIABLE;
+    const smtlib_smt_ast *sa = static_cast<const smtlib_smt_ast *>(a);
+    const smtlib_smt_ast *atom = sa;
+    if(sa->kind == SMT_FUNC_NOT)
+      atom = static_cast<const smtlib_smt_ast *>(sa->args[0]);
+
+    if(atom->kind != SMT_FUNC_SYMBOL)
+    {
+      smt_astt lit = mk_fresh(boolean_sort, "smtlib::assumption");
+      assert_ast(mk_eq(lit, a));
+      sa = atom = static_cast<const smtlib_smt_ast *>(lit);
+    }
+
+    std::string name;
+    emit_terminal_ast(atom, name);
+    lits += sa == atom ? " " + name : " (not " + name + ")";
   }
+
+  emit("(check-sat-assuming (%s))\n", lits.c_str());
+  flush();
+
+  if(!emit_proc)
+    return smt_convt::P_SMTLIB;
+
+  return read_check_sat();
+}
+
+smt_convt::resultt smtlib_convt::read_check_sat()
+{
+  emit_proc->parse(TOK_START_SAT);
+
+  // This should generate on sexpr. See what it is.
+  resultt res;
+  if(smtlib_output->token == TOK_KW_SAT)
+    res = smt_convt::P_SATISFIABLE;
+  else if(smtlib_output->token == TOK_KW_UNSAT)
+    res = smt_convt::P_UNSATISFIABLE;
   else if(smtlib_output->token == TOK_KW_ERROR)
   {
     log_error("SMTLIB solver returned error: \"{}\"", smtlib_output->data);
-    return smt_convt::P_ERROR;
+    emit_proc->broken = true;
+    res = smt_convt::P_ERROR;
   }
   else
   {
     log_error("Unrecognized check-sat output from smtlib solver");
     abort();
   }
+
+  delete smtlib_output;
+  return res;
 }
 
 BigInt smtlib_convt::get_bv(smt_astt a, bool is_signed)
@@ -606,8 +751,7 @@ BigInt smtlib_convt::get_bv(smt_astt a, bool is_signed)
 
   emit("(get-value (|%s|))\n", name.c_str());
   flush();
-  smtlib_send_start_code = 1;
-  smtlibparse(TOK_START_VALUE);
+  emit_proc->parse(TOK_START_VALUE);
 
   if(smtlib_output->token == TOK_KW_ERROR)
   {
@@ -687,8 +831,7 @@ smtlib_convt::get_array_elem(smt_astt array, uint64_t index, const type2tc &t)
     index,
     domain_width);
   flush();
-  smtlib_send_start_code = 1;
-  smtlibparse(TOK_START_VALUE);
+  emit_proc->parse(TOK_START_VALUE);
 
   if(smtlib_output->token == TOK_KW_ERROR)
   {
@@ -834,7 +977,7 @@ template <typename... Ts>
 void smtlib_convt::emit(const Ts &...ts) const
 {
   if(emit_proc)
-    emit_proc.emit(ts...);
+    emit_proc->emit(ts...);
   if(emit_opt_output)
     emit_opt_output.emit(ts...);
 }
@@ -842,31 +985,66 @@ void smtlib_convt::emit(const Ts &...ts) const
 void smtlib_convt::flush() const
 {
   if(emit_proc)
-    emit_proc.flush();
+    emit_proc->flush();
   if(emit_opt_output)
     emit_opt_output.flush();
 }
 
-smtlib_convt::process_emitter::operator bool() const noexcept
-{
-  return out_stream != nullptr;
-}
-
 template <typename... Ts>
 void smtlib_convt::process_emitter::emit(const char *fmt, Ts &&...ts) const
 {
-  /* TODO: other error handling */
-  errno = 0;
-  if(fprintf(out_stream, fmt, ts...) < 0 && errno == EPIPE)
-    throw external_process_died(read_all(in_stream));
+  // Most commands are short enough to be formatted only once
+  char buf[256];
+  int n = snprintf(buf, sizeof(buf), fmt, ts...);
+  assert(n >= 0);
+  if(static_cast<size_t>(n) < sizeof(buf))
+    out_buf.append(buf, n);
+  else
+  {
+    size_t old_size = out_buf.size();
+    out_buf.resize(old_size + n + 1);
+    snprintf(&out_buf[old_size], n + 1, fmt, ts...);
+    out_buf.resize(old_size + n);
+  }
+
+  if(out_buf.size() >= 1 << 16)
+    flush();
 }
 
 void smtlib_convt::process_emitter::flush() const
 {
-  /* TODO: other error handling */
-  errno = 0;
-  if(fflush(out_stream) == EOF && errno == EPIPE)
-    throw external_process_died(read_all(in_stream));
+#ifndef _WIN32
+  const char *p = out_buf.data();
+  size_t left = out_buf.size();
+  while(left > 0)
+  {
+    ssize_t written = write(out_fd, p, left);
+    if(written < 0)
+    {
+      if(errno == EINTR)
+        continue;
+      broken = true;
+      /* TODO: other error handling */
+      if(errno == EPIPE)
+        throw external_process_died(read_all(in_stream));
+      log_error("Writing to smtlib solver: {}", strerror(errno));
+      abort();
+    }
+    p += written;
+    left -= written;
+  }
+#endif
+  out_buf.clear();
+}
+
+void smtlib_convt::process_emitter::parse(int start_token) const
+{
+  // The lexer may still hold input from another session
+  if(smtlib_tokin != in_stream)
+    smtlib_tokrestart(in_stream);
+
+  smtlib_send_start_code = 1;
+  smtlibparse(start_token);
 }
 
 smtlib_convt::file_emitter::operator bool() const noexcept
@@ -898,8 +1076,7 @@ bool smtlib_convt::get_bool(smt_astt a)
   emit("%s", "))\n");
   flush();
 
-  smtlib_send_start_code = 1;
-  smtlibparse(TOK_START_VALUE);
+  emit_proc->parse(TOK_START_VALUE);
 
   if(smtlib_output->token == TOK_KW_ERROR)
   {
@@ -948,7 +1125,7 @@ bool smtlib_convt::get_bool(smt_astt a)
 const std::string smtlib_convt::solver_text()
 {
   if(emit_proc)
-    return emit_proc.solver_name + " version " + emit_proc.solver_version;
+    return emit_proc->solver_name + " version " + emit_proc->solver_version;
 
   if(emit_opt_output)
     return "Text output";
@@ -1,7 +1,12 @@
 #ifndef _ESBMC_SOLVERS_SMTLIB_SMTLIB_CONV_H
 #define _ESBMC_SOLVERS_SMTLIB_SMTLIB_CONV_H
 
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index_container.hpp>
 #include <list>
+#include <memory>
 #include <solvers/smt/smt_conv.h>
 #include <string>
 #ifndef _WIN32
@@ -180,6 +185,8 @@ public:
   ~smtlib_convt() override;
 
   resultt dec_solve() override;
+  resultt dec_solve_assuming(const ast_vec &assumptions) override;
+  resultt read_check_sat();
   const std::string solver_text() override;
 
   smt_astt mk_add(smt_astt a, smt_astt b) override;
@@ -289,15 +296,26 @@ public:
 
   // Members
 
+  /** A session with an external solver process. Sessions are kept alive
+   *  when their smtlib_convt is destroyed and handed to the next one created
+   *  for the same solver command and logic, which saves the fork and the
+   *  solver's start-up. The formula of each smtlib_convt is kept in its own
+   *  (push)/(pop) scope so the next one starts from the preamble only. */
   struct process_emitter
   {
-    FILE *out_stream;
+    int out_fd;
     FILE *in_stream;
-    void *org_sigpipe_handler; /* TODO: static */
+    long owner_pid; /* process which forked the solver */
 
     std::string solver_name;
     std::string solver_version;
 
+    /* Commands not yet written to the solver. Flushed with a single write
+     * when a response is expected, or when it grows too large. */
+    mutable std::string out_buf;
+    /* Set when the session is in an unknown state and must not be reused */
+    mutable bool broken;
+
     explicit process_emitter(const std::string &cmd);
     process_emitter(const process_emitter &) = delete;
 
@@ -309,9 +327,13 @@ public:
     void emit(const char *fmt, Ts &&...) const;
     void flush() const;
 
-    explicit operator bool() const noexcept;
-  } emit_proc;
+    /* Reads one response, starting the parser at start_token. The result is
+     * left in smtlib_output. */
+    void parse(int start_token) const;
+  };
 
+  std::unique_ptr<process_emitter> emit_proc;
+  std::string session_key;
   struct file_emitter
   {
     FILE *out_stream;
@@ -108,6 +108,11 @@ pick_solver(std::string &solver_name, const optionst &options)
   abort();
 }
 
+bool is_solver_available(const std::string &solver_name)
+{
+  return esbmc_solvers.count(solver_name) != 0;
+}
+
 smt_convt *create_solver(
   std::string solver_name,
   const namespacet &ns,
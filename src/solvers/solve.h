@@ -14,6 +14,9 @@ typedef smt_convt *(solver_creator)(
   array_iface **array_api,
   fp_convt **fp_api);
 
+/// Whether the backend called \p solver_name was built in
+bool is_solver_available(const std::string &solver_name);
+
 smt_convt *create_solver(
   std::string solver_name,
   const namespacet &ns,
@@ -98,6 +98,25 @@ smt_convt::resultt yices_convt::dec_solve()
   return smt_convt::P_ERROR;
 }
 
+smt_convt::resultt yices_convt::dec_solve_assuming(const ast_vec &assumptions)
+{
+  pre_solve();
+
+  std::vector<term_t> assumed;
+  for(smt_astt a : assumptions)
+    assumed.push_back(to_solver_smt_ast<yices_smt_ast>(a)->a);
+
+  smt_status_t result = yices_check_context_with_assumptions(
+    yices_ctx, nullptr, assumed.size(), assumed.data());
+  if(result == STATUS_SAT)
+    return smt_convt::P_SATISFIABLE;
+
+  if(result == STATUS_UNSAT)
+    return smt_convt::P_UNSATISFIABLE;
+
+  return smt_convt::P_ERROR;
+}
+
 const std::string yices_convt::solver_text()
 {
   std::stringstream ss;
@@ -96,6 +96,25 @@ smt_convt::resultt z3_convt::dec_solve()
   return smt_convt::P_ERROR;
 }
 
+smt_convt::resultt z3_convt::dec_solve_assuming(const ast_vec &assumptions)
+{
+  pre_solve();
+
+  z3::expr_vector assumed(z3_ctx);
+  for(smt_astt a : assumptions)
+    assumed.push_back(to_solver_smt_ast<z3_smt_ast>(a)->a);
+
+  z3::check_result result = solver.check(assumed);
+
+  if(result == z3::sat)
+    return P_SATISFIABLE;
+
+  if(result == z3::unsat)
+    return smt_convt::P_UNSATISFIABLE;
+
+  return smt_convt::P_ERROR;
+}
+
 void z3_convt::assert_ast(smt_astt a)
 {
   z3::expr theval = to_solver_smt_ast<z3_smt_ast>(a)->a;
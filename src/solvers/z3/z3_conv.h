@@ -35,6 +35,7 @@ public:
   void push_ctx() override;
   void pop_ctx() override;
   smt_convt::resultt dec_solve() override;
+  smt_convt::resultt dec_solve_assuming(const ast_vec &assumptions) override;
 
   bool get_bool(smt_astt a) override;
   BigInt get_bv(smt_astt a, bool is_signed) override;
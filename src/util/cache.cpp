@@ -1,3 +1,5 @@
+#include <cstdio>
+#include <fstream>
 #include <util/cache.h>
 #include <util/message.h>
 #include <utility>
@@ -27,3 +29,107 @@ bool assertion_cache::run(symex_target_equationt::SSA_stepst &eq)
     hits);
   return true;
 }
+
+static const char *persistent_cache_header = "# ESBMC assertion cache v1";
+
+persistent_assert_cache::persistent_assert_cache(
+  std::string path,
+  std::string salt)
+  : path(std::move(path)), salt(std::move(salt))
+{
+  load(proven);
+  log_status("Loaded {} proven formula(s) from {}", proven.size(), this->path);
+}
+
+void persistent_assert_cache::load(std::set<std::string> &into) const
+{
+  std::ifstream in(path);
+  if(!in)
+    return;
+
+  std::string line;
+  if(!std::getline(in, line) || line != persistent_cache_header)
+  {
+    log_warning("Ignoring assertion cache {}: unknown format", path);
+    return;
+  }
+
+  while(std::getline(in, line))
+    if(!line.empty())
+      into.insert(line);
+}
+
+std::string persistent_assert_cache::digest(
+  const symex_target_equationt::SSA_stepst &eq) const
+{
+  // Stored on disk, hence SHA-1 rather than the fast in-process digest
+  crypto_hash h(crypto_hash::enginet::sha1);
+  h.ingest(salt.data(), salt.size());
+
+  for(const auto &step : eq)
+  {
+    // Output steps do not constrain the formula
+    if(step.ignore || step.is_output() || step.is_skip())
+      continue;
+
+    const unsigned int type = step.type;
+    h.ingest(&type, sizeof(type));
+    step.guard->hash(h);
+    if(step.is_renumber())
+    {
+      step.lhs->hash(h);
+      step.rhs->hash(h);
+    }
+    else
+      step.cond->hash(h);
+  }
+
+  h.fin();
+  return h.to_string();
+}
+
+bool persistent_assert_cache::contains(const std::string &digest) const
+{
+  std::lock_guard<std::mutex> guard(lock);
+  return proven.count(digest);
+}
+
+void persistent_assert_cache::insert(const std::string &digest)
+{
+  std::lock_guard<std::mutex> guard(lock);
+  modified |= proven.insert(digest).second;
+}
+
+bool persistent_assert_cache::save()
+{
+  std::lock_guard<std::mutex> guard(lock);
+  if(!modified)
+    return false;
+
+  // Another run may have updated the file in the meantime
+  load(proven);
+
+  const std::string tmp = path + ".tmp";
+  {
+    std::ofstream out(tmp);
+    out << persistent_cache_header << '\n';
+    for(const auto &d : proven)
+      out << d << '\n';
+    if(!out)
+    {
+      log_error("Could not write the assertion cache to {}", tmp);
+      return true;
+    }
+  }
+
+  if(std::rename(tmp.c_str(), path.c_str()))
+  {
+    log_error("Could not write the assertion cache to {}", path);
+    std::remove(tmp.c_str());
+    return true;
+  }
+
+  modified = false;
+  log_status("Saved {} proven formula(s) to {}", proven.size(), path);
+  return false;
+}
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <mutex>
+#include <set>
+#include <string>
 #include <unordered_set>
 
 #include <util/algorithms.h>
@@ -37,3 +40,47 @@ protected:
 private:
   BigInt hits = 0;
 };
+
+/**
+ * @Brief Set of formulas which were already proven correct, persisted in a
+ *        file so that it survives between runs.
+ *
+ *        A formula is identified by a SHA-1 digest over the guard and
+ *        condition of each of its (non ignored) steps, plus a salt
+ *        describing the options that change its meaning (e.g. the
+ *        encoding). Since the steps are those left after slicing, a claim
+ *        only has to be verified again if its cone of influence changed.
+ */
+class persistent_assert_cache
+{
+public:
+  persistent_assert_cache(std::string path, std::string salt);
+
+  /// Digest of the steps of \eq which are not ignored
+  std::string digest(const symex_target_equationt::SSA_stepst &eq) const;
+
+  bool contains(const std::string &digest) const;
+
+  /// Records \digest as proven; safe to call from several threads
+  void insert(const std::string &digest);
+
+  /**
+   * Merges the entries with the ones currently in the file and writes
+   * the result back (through a temporary file, so that readers never see
+   * a partially written cache)
+   *
+   * @return true if the cache could not be written
+   */
+  bool save();
+
+protected:
+  const std::string path;
+  const std::string salt;
+
+private:
+  mutable std::mutex lock;
+  std::set<std::string> proven;
+  bool modified = false;
+
+  void load(std::set<std::string> &into) const;
+};
@@ -15,6 +15,28 @@ public:
   boost::uuids::detail::sha1 s;
 };
 
+// Primes of xxHash64
+static const uint64_t prime1 = 11400714785074694791ULL;
+static const uint64_t prime2 = 14029467366897019727ULL;
+static const uint64_t prime3 = 1609587929392839161ULL;
+static const uint64_t prime4 = 9650029242287828579ULL;
+static const uint64_t prime5 = 2870177450012600261ULL;
+
+static inline uint64_t rotl(uint64_t x, unsigned r)
+{
+  return (x << r) | (x >> (64 - r));
+}
+
+static inline uint64_t avalanche(uint64_t h)
+{
+  h ^= h >> 33;
+  h *= prime2;
+  h ^= h >> 29;
+  h *= prime3;
+  h ^= h >> 32;
+  return h;
+}
+
 bool crypto_hash::operator<(const crypto_hash &h2) const
 {
   if(memcmp(hash, h2.hash, sizeof(hash)) < 0)
@@ -32,17 +54,77 @@ std::string crypto_hash::to_string() const
   return buf.str();
 }
 
-crypto_hash::crypto_hash()
-  : p_crypto(std::make_shared<crypto_hash_private>()), hash{0}
+crypto_hash::crypto_hash(enginet engine)
+  : hash{0}, engine(engine), lanes{prime1 + prime2, prime4 - prime3}
+{
+  if(engine == enginet::sha1)
+    p_crypto = std::make_shared<crypto_hash_private>();
+}
+
+void crypto_hash::fast_word(uint64_t word)
 {
+  // One xxHash64 round per lane, with different constants
+  lanes[0] = rotl(lanes[0] + word * prime2, 31) * prime1;
+  lanes[1] = rotl(lanes[1] + word * prime4, 27) * prime3;
 }
 
 void crypto_hash::ingest(void const *data, unsigned int size)
 {
-  p_crypto->s.process_bytes(data, size);
+  if(engine == enginet::sha1)
+  {
+    p_crypto->s.process_bytes(data, size);
+    return;
+  }
+
+  const uint8_t *bytes = static_cast<const uint8_t *>(data);
+  length += size;
+
+  // Complete the pending word first
+  while(pending_size > 0 && size > 0)
+  {
+    pending[pending_size++] = *bytes++;
+    --size;
+    if(pending_size == sizeof(pending))
+    {
+      uint64_t word;
+      memcpy(&word, pending, sizeof(word));
+      fast_word(word);
+      pending_size = 0;
+    }
+  }
+
+  for(; size >= sizeof(uint64_t); size -= sizeof(uint64_t))
+  {
+    uint64_t word;
+    memcpy(&word, bytes, sizeof(word));
+    fast_word(word);
+    bytes += sizeof(word);
+  }
+
+  memcpy(pending + pending_size, bytes, size);
+  pending_size += size;
 }
 
 void crypto_hash::fin()
 {
-  p_crypto->s.get_digest(hash);
+  if(engine == enginet::sha1)
+  {
+    p_crypto->s.get_digest(hash);
+    return;
+  }
+
+  // The remaining bytes and the length, which tells apart data only
+  // differing by trailing zeros, end the stream
+  uint64_t word = 0;
+  memcpy(&word, pending, pending_size);
+  fast_word(word);
+  fast_word(length);
+
+  uint64_t h0 = avalanche(lanes[0] ^ rotl(lanes[1], 17));
+  uint64_t h1 = avalanche(lanes[1] + lanes[0] * prime5);
+  hash[0] = h0;
+  hash[1] = h0 >> 32;
+  hash[2] = h1;
+  hash[3] = h1 >> 32;
+  hash[4] = 0;
 }
@@ -1,14 +1,33 @@
 #ifndef _CPROVER_SRC_GOTO_SYMEX_CRYPTO_HASH_H_
 #define _CPROVER_SRC_GOTO_SYMEX_CRYPTO_HASH_H_
 
+#include <cstdint>
 #include <memory>
 #include <string>
 
 class crypto_hash_private;
 
+/**
+ * Digest of a stream of data, computed by one of two engines:
+ *
+ *  - fast: a 128 bit non cryptographic hash (two xxHash64 style lanes), the
+ *    default. It is meant for in-process tables, e.g. state hashing and the
+ *    assertion cache, and needs no heap allocation.
+ *  - sha1: SHA-1, for identities that are stored on disk or compared with
+ *    other tools.
+ *
+ * The digest is only available in #hash after fin(). The fast engine leaves
+ * its last word zero.
+ */
 class crypto_hash
 {
 public:
+  enum class enginet
+  {
+    fast,
+    sha1
+  };
+
   std::shared_ptr<crypto_hash_private> p_crypto;
   unsigned int hash[5];
 
@@ -25,9 +44,20 @@ public:
 
   std::string to_string() const;
 
-  crypto_hash();
+  explicit crypto_hash(enginet engine = enginet::fast);
   void ingest(void const *data, unsigned int size);
   void fin();
+
+private:
+  enginet engine;
+
+  // State of the fast engine
+  uint64_t lanes[2];
+  uint64_t length = 0;
+  uint8_t pending[8];
+  unsigned int pending_size = 0;
+
+  void fast_word(uint64_t word);
 };
 
 #endif /* _CPROVER_SRC_GOTO_SYMEX_CRYPTO_HASH_H_ */
@@ -0,0 +1,452 @@
+#pragma once
+
+#include <bitset>
+#include <cassert>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Persistent (copy-on-write) hash map, implemented as a hash array
+ *        mapped trie (HAMT).
+ *
+ * Copying a hamt_mapt is O(1): both copies share every node of the trie.
+ * Modifying a map only copies the nodes on the path from the root to the
+ * modified entry that are still shared with some other map (plus the entry
+ * itself), in the same spirit as the detach facility of irep_container.
+ *
+ * Every node branches on 5 bits of the key's hash. Entries whose hashes are
+ * equal up to the last level end up in a collision node, searched linearly.
+ *
+ * References to mapped values returned by the non-const methods remain valid
+ * until the next modification or copy of the map.
+ */
+template <
+  class Key,
+  class T,
+  class Hash = std::hash<Key>,
+  class KeyEqual = std::equal_to<Key>>
+class hamt_mapt
+{
+public:
+  typedef Key key_type;
+  typedef T mapped_type;
+  typedef std::pair<const Key, T> value_type;
+
+private:
+  static constexpr unsigned bits = 5;
+  static constexpr unsigned max_depth = (sizeof(size_t) * 8) / bits;
+
+  typedef std::shared_ptr<value_type> leaf_ptr;
+  struct nodet;
+  typedef std::shared_ptr<nodet> node_ptr;
+
+  struct nodet
+  {
+    /// Which fragments hold an entry, resp. a child node. Unused in
+    /// collision nodes (depth == max_depth).
+    uint32_t datamap = 0;
+    uint32_t nodemap = 0;
+    /// Entries and children, in the order of their fragments
+    std::vector<leaf_ptr> leaves;
+    std::vector<node_ptr> children;
+
+    bool empty() const
+    {
+      return leaves.empty() && children.empty();
+    }
+  };
+
+  node_ptr root;
+  size_t count = 0;
+
+  static uint32_t fragment(size_t hash, unsigned depth)
+  {
+    return uint32_t(1) << ((hash >> (bits * depth)) & 31);
+  }
+
+  static unsigned index(uint32_t map, uint32_t bit)
+  {
+    return std::bitset<32>(map & (bit - 1)).count();
+  }
+
+  static nodet *own(node_ptr &p)
+  {
+    if(!p)
+      p = std::make_shared<nodet>();
+    else if(p.use_count() > 1)
+      p = std::make_shared<nodet>(*p);
+    return p.get();
+  }
+
+  static value_type *own(leaf_ptr &p)
+  {
+    if(p.use_count() > 1)
+      p = std::make_shared<value_type>(*p);
+    return p.get();
+  }
+
+  /// Node holding only \l, placed at \depth
+  static node_ptr make_single(const leaf_ptr &l, unsigned depth)
+  {
+    node_ptr n = std::make_shared<nodet>();
+    if(depth < max_depth)
+      n->datamap = fragment(Hash()(l->first), depth);
+    n->leaves.push_back(l);
+    return n;
+  }
+
+  bool erase_rec(node_ptr &p, size_t hash, const Key &key, unsigned depth)
+  {
+    if(!p)
+      return false;
+
+    if(depth == max_depth)
+    {
+      for(size_t i = 0; i < p->leaves.size(); i++)
+        if(KeyEqual()(p->leaves[i]->first, key))
+        {
+          nodet *n = own(p);
+          n->leaves.erase(n->leaves.begin() + i);
+          return true;
+        }
+      return false;
+    }
+
+    uint32_t bit = fragment(hash, depth);
+    if(p->datamap & bit)
+    {
+      unsigned idx = index(p->datamap, bit);
+      if(!KeyEqual()(p->leaves[idx]->first, key))
+        return false;
+      nodet *n = own(p);
+      n->leaves.erase(n->leaves.begin() + idx);
+      n->datamap &= ~bit;
+      return true;
+    }
+
+    if(p->nodemap & bit)
+    {
+      unsigned idx = index(p->nodemap, bit);
+      // Only copy this node if something below is actually removed
+      node_ptr child = p->children[idx];
+      if(!erase_rec(child, hash, key, depth + 1))
+        return false;
+      nodet *n = own(p);
+      if(child->empty())
+      {
+        n->children.erase(n->children.begin() + idx);
+        n->nodemap &= ~bit;
+      }
+      else
+        n->children[idx] = std::move(child);
+      return true;
+    }
+
+    return false;
+  }
+
+  template <class F>
+  static void diff_rec(const nodet *mine, const nodet *theirs, F &f, unsigned d)
+  {
+    if(mine == theirs)
+      return; // Shared subtree, nothing differs
+
+    if(d == max_depth)
+    {
+      for(const auto &l : theirs->leaves)
+      {
+        bool shared = false;
+        if(mine)
+          for(const auto &m : mine->leaves)
+            shared |= m == l;
+        if(!shared)
+          f(*l);
+      }
+      return;
+    }
+
+    for(uint32_t bit = 1; bit; bit <<= 1)
+    {
+      if(theirs->datamap & bit)
+      {
+        const leaf_ptr &l = theirs->leaves[index(theirs->datamap, bit)];
+        if(!(mine && (mine->datamap & bit) &&
+             mine->leaves[index(mine->datamap, bit)] == l))
+          f(*l);
+      }
+      else if(theirs->nodemap & bit)
+      {
+        const nodet *child =
+          theirs->children[index(theirs->nodemap, bit)].get();
+        const nodet *my_child = nullptr;
+        if(mine && (mine->nodemap & bit))
+          my_child = mine->children[index(mine->nodemap, bit)].get();
+        diff_rec(my_child, child, f, d + 1);
+      }
+    }
+  }
+
+public:
+  class const_iterator
+  {
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef typename hamt_mapt::value_type value_type;
+    typedef const value_type *pointer;
+    typedef const value_type &reference;
+    typedef std::ptrdiff_t difference_type;
+
+    const_iterator() = default;
+
+    reference operator*() const
+    {
+      return *current;
+    }
+
+    pointer operator->() const
+    {
+      return current;
+    }
+
+    const_iterator &operator++()
+    {
+      advance();
+      return *this;
+    }
+
+    const_iterator operator++(int)
+    {
+      const_iterator tmp = *this;
+      advance();
+      return tmp;
+    }
+
+    bool operator==(const const_iterator &o) const
+    {
+      return current == o.current;
+    }
+
+    bool operator!=(const const_iterator &o) const
+    {
+      return current != o.current;
+    }
+
+  private:
+    friend class hamt_mapt;
+
+    struct framet
+    {
+      const nodet *node;
+      size_t leaf;
+      size_t child;
+    };
+    std::vector<framet> stack;
+    const value_type *current = nullptr;
+
+    explicit const_iterator(const nodet *root)
+    {
+      if(root)
+        stack.push_back({root, 0, 0});
+      advance();
+    }
+
+    void advance()
+    {
+      while(!stack.empty())
+      {
+        framet &f = stack.back();
+        if(f.leaf < f.node->leaves.size())
+        {
+          current = f.node->leaves[f.leaf++].get();
+          return;
+        }
+        if(f.child < f.node->children.size())
+        {
+          const nodet *c = f.node->children[f.child++].get();
+          stack.push_back({c, 0, 0});
+          continue;
+        }
+        stack.pop_back();
+      }
+      current = nullptr;
+    }
+  };
+
+  const_iterator begin() const
+  {
+    return const_iterator(root.get());
+  }
+
+  const_iterator end() const
+  {
+    return const_iterator();
+  }
+
+  size_t size() const noexcept
+  {
+    return count;
+  }
+
+  bool empty() const noexcept
+  {
+    return count == 0;
+  }
+
+  void clear()
+  {
+    root.reset();
+    count = 0;
+  }
+
+  /// Returns the value mapped to \key, or nullptr if there is none
+  const T *lookup(const Key &key) const
+  {
+    const size_t hash = Hash()(key);
+    const nodet *n = root.get();
+    for(unsigned depth = 0; n; depth++)
+    {
+      if(depth == max_depth)
+      {
+        for(const auto &l : n->leaves)
+          if(KeyEqual()(l->first, key))
+            return &l->second;
+        return nullptr;
+      }
+
+      uint32_t bit = fragment(hash, depth);
+      if(n->datamap & bit)
+      {
+        const leaf_ptr &l = n->leaves[index(n->datamap, bit)];
+        return KeyEqual()(l->first, key) ? &l->second : nullptr;
+      }
+      if(!(n->nodemap & bit))
+        return nullptr;
+      n = n->children[index(n->nodemap, bit)].get();
+    }
+    return nullptr;
+  }
+
+  /// Like lookup(), but the value may be modified. This unshares the path to
+  /// the entry, so it should only be used when a modification is intended.
+  T *lookup_mutable(const Key &key)
+  {
+    if(!lookup(key))
+      return nullptr;
+
+    const size_t hash = Hash()(key);
+    nodet *n = own(root);
+    for(unsigned depth = 0;; depth++)
+    {
+      if(depth == max_depth)
+      {
+        for(auto &l : n->leaves)
+          if(KeyEqual()(l->first, key))
+            return &own(l)->second;
+        assert(0 && "hamt_mapt: key vanished");
+        return nullptr;
+      }
+
+      uint32_t bit = fragment(hash, depth);
+      if(n->datamap & bit)
+        return &own(n->leaves[index(n->datamap, bit)])->second;
+      n = own(n->children[index(n->nodemap, bit)]);
+    }
+  }
+
+  /**
+   * Maps \key to \value unless \key is mapped already.
+   *
+   * @return the (modifiable) value mapped to \key, and whether it was inserted
+   */
+  std::pair<T *, bool> emplace(const Key &key, const T &value)
+  {
+    const size_t hash = Hash()(key);
+    nodet *n = own(root);
+    for(unsigned depth = 0;; depth++)
+    {
+      if(depth == max_depth)
+      {
+        for(auto &l : n->leaves)
+          if(KeyEqual()(l->first, key))
+            return {&own(l)->second, false};
+        n->leaves.push_back(std::make_shared<value_type>(key, value));
+        ++count;
+        return {&n->leaves.back()->second, true};
+      }
+
+      uint32_t bit = fragment(hash, depth);
+      if(n->datamap & bit)
+      {
+        unsigned idx = index(n->datamap, bit);
+        leaf_ptr &l = n->leaves[idx];
+        if(KeyEqual()(l->first, key))
+          return {&own(l)->second, false};
+
+        // Push the existing entry one level down, then keep descending
+        node_ptr child = make_single(l, depth + 1);
+        n->leaves.erase(n->leaves.begin() + idx);
+        n->datamap &= ~bit;
+        n->children.insert(
+          n->children.begin() + index(n->nodemap, bit), std::move(child));
+        n->nodemap |= bit;
+      }
+
+      if(n->nodemap & bit)
+      {
+        n = own(n->children[index(n->nodemap, bit)]);
+        continue;
+      }
+
+      auto it = n->leaves.insert(
+        n->leaves.begin() + index(n->datamap, bit),
+        std::make_shared<value_type>(key, value));
+      n->datamap |= bit;
+      ++count;
+      return {&(*it)->second, true};
+    }
+  }
+
+  /// Maps \key to \value, replacing any previous value
+  void set(const Key &key, const T &value)
+  {
+    auto res = emplace(key, value);
+    if(!res.second)
+      *res.first = value;
+  }
+
+  /// @return whether \key was mapped
+  bool erase(const Key &key)
+  {
+    if(!erase_rec(root, Hash()(key), key, 0))
+      return false;
+    --count;
+    if(root->empty())
+      root.reset();
+    return true;
+  }
+
+  /**
+   * Calls \f on every entry of \other which is not physically shared with
+   * this map. Subtrees shared between both maps (e.g. because one is a
+   * modified copy of the other) are skipped as a whole, hence the cost is
+   * proportional to the difference between the two maps rather than their
+   * size. \f may modify this map.
+   *
+   * Note that entries which are equal but not shared are reported too.
+   */
+  template <class F>
+  void for_each_difference(const hamt_mapt &other, F f) const
+  {
+    if(!other.root)
+      return;
+    // Keep the current trie alive and unmodified during the walk, even if \f
+    // modifies this map: every node is now shared, so it will be copied.
+    const node_ptr snapshot = root;
+    diff_rec(snapshot.get(), other.root.get(), f, 0);
+  }
+};
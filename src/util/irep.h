@@ -111,6 +111,7 @@ public:
   //protected:
   // This class has to be able to fiddle with ireps directly.
   friend class irep_serializationt;
+  friend class irep_flat_writert;
 
   const irept &find(const irep_namet &name) const;
   irept &add(const irep_namet &name);
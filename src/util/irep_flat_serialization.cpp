@@ -0,0 +1,177 @@
+#include <util/irep_flat_serialization.h>
+
+void irep_flat_writert::write_word(std::ostream &out, uint32_t w)
+{
+  out.put(w & 0xFF);
+  out.put((w >> 8) & 0xFF);
+  out.put((w >> 16) & 0xFF);
+  out.put((w >> 24) & 0xFF);
+}
+
+unsigned irep_flat_writert::add_string(const irep_idt &s)
+{
+  auto res = string_numbers.emplace(s.get_no(), strings.size());
+  if(res.second)
+    strings.push_back(s);
+  return res.first->second;
+}
+
+unsigned irep_flat_writert::add(const irept &irep)
+{
+  auto shared = shared_numbers.find(&irep.read());
+  if(shared != shared_numbers.end())
+    return shared->second.second;
+
+  // Sub-nodes are numbered first, hence a node only ever refers to nodes
+  // with a smaller number, and equal records mean equal sub-trees.
+  std::vector<uint32_t> record;
+  record.push_back(add_string(irep.id()));
+  record.push_back(irep.get_sub().size());
+  record.push_back(irep.get_named_sub().size() + irep.get_comments().size());
+
+  forall_irep(it, irep.get_sub())
+    record.push_back(add(*it));
+
+  forall_named_irep(it, irep.get_named_sub())
+  {
+    record.push_back(add_string(it->first));
+    record.push_back(add(it->second));
+  }
+
+  forall_named_irep(it, irep.get_comments())
+  {
+    record.push_back(add_string(it->first));
+    record.push_back(add(it->second));
+  }
+
+  auto res = node_numbers.emplace(std::move(record), nodes.size());
+  if(res.second)
+    nodes.push_back(&res.first->first);
+  shared_numbers.emplace(&irep.read(), std::make_pair(irep, res.first->second));
+  return res.first->second;
+}
+
+void irep_flat_writert::write(std::ostream &out) const
+{
+  // String table: count, end offset of every string, then the characters
+  write_word(out, strings.size());
+  uint32_t offset = 0;
+  for(const auto &s : strings)
+  {
+    offset += s.size();
+    write_word(out, offset);
+  }
+  for(const auto &s : strings)
+    out << s.as_string();
+
+  // Node table: count, total number of words, word offset of every node, then
+  // the nodes
+  uint32_t words = 0;
+  for(const auto *n : nodes)
+    words += n->size();
+
+  write_word(out, nodes.size());
+  write_word(out, words);
+  offset = 0;
+  for(const auto *n : nodes)
+  {
+    write_word(out, offset);
+    offset += n->size();
+  }
+  for(const auto *n : nodes)
+    for(uint32_t w : *n)
+      write_word(out, w);
+}
+
+const uint8_t *irep_flat_readert::open(const uint8_t *data, const uint8_t *end)
+{
+  auto words_left = [&data, end]() -> size_t { return (end - data) / 4; };
+
+  if(words_left() < 1)
+    return nullptr;
+  string_count = read_word(data);
+  data += 4;
+  if(words_left() < string_count)
+    return nullptr;
+  string_offsets = data;
+  data += 4 * size_t(string_count);
+  string_data = data;
+  string_bytes =
+    string_count ? read_word(string_offsets + 4 * (string_count - 1)) : 0;
+  if(size_t(end - data) < string_bytes)
+    return nullptr;
+  data += string_bytes;
+
+  if(words_left() < 2)
+    return nullptr;
+  node_count = read_word(data);
+  node_words = read_word(data + 4);
+  data += 8;
+  if(words_left() < size_t(node_count) + node_words)
+    return nullptr;
+  node_offsets = data;
+  data += 4 * size_t(node_count);
+  node_data = data;
+  data += 4 * size_t(node_words);
+
+  string_cache.assign(string_count, irep_idt());
+  string_built.assign(string_count, false);
+  node_cache.assign(node_count, irept());
+  node_built.assign(node_count, false);
+  return data;
+}
+
+const irep_idt &irep_flat_readert::get_string(unsigned n)
+{
+  static const irep_idt empty;
+  if(n >= string_count)
+    return empty;
+
+  if(!string_built[n])
+  {
+    uint32_t begin = n ? read_word(string_offsets + 4 * (n - 1)) : 0;
+    uint32_t end = read_word(string_offsets + 4 * n);
+    if(begin <= end && end <= string_bytes)
+      string_cache[n] = irep_idt(std::string(
+        reinterpret_cast<const char *>(string_data) + begin, end - begin));
+    string_built[n] = true;
+  }
+  return string_cache[n];
+}
+
+const irept &irep_flat_readert::get(unsigned n)
+{
+  if(n >= node_count)
+    return get_nil_irep();
+
+  if(node_built[n])
+    return node_cache[n];
+
+  uint32_t offset = read_word(node_offsets + 4 * size_t(n));
+  if(offset > node_words || node_words - offset < 3)
+    return get_nil_irep();
+  const uint8_t *p = node_data + 4 * size_t(offset);
+  uint32_t nsub = read_word(p + 4);
+  uint32_t nnamed = read_word(p + 8);
+  if(node_words - offset - 3 < size_t(nsub) + 2 * size_t(nnamed))
+    return get_nil_irep();
+
+  irept irep(get_string(read_word(p)));
+  p += 12;
+
+  // Only refer to nodes with smaller numbers, which also rules out cycles
+  auto sub_node = [this, n](uint32_t m) -> const irept & {
+    return m < n ? get(m) : get_nil_irep();
+  };
+
+  irep.get_sub().reserve(nsub);
+  for(uint32_t i = 0; i < nsub; i++, p += 4)
+    irep.get_sub().push_back(sub_node(read_word(p)));
+
+  for(uint32_t i = 0; i < nnamed; i++, p += 8)
+    irep.add(get_string(read_word(p))) = sub_node(read_word(p + 4));
+
+  node_cache[n] = irep;
+  node_built[n] = true;
+  return node_cache[n];
+}
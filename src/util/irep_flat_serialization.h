@@ -0,0 +1,86 @@
+#ifndef IREP_FLAT_SERIALIZATION_H_
+#define IREP_FLAT_SERIALIZATION_H_
+
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <unordered_map>
+#include <util/irep.h>
+#include <vector>
+
+/** Flat encoding of a set of ireps, used by version 2 goto binaries.
+ *
+ *  All ireps are stored in two tables: a string table, and a node table in
+ *  which every node holds its id and the numbers of its (named) sub-nodes.
+ *  Structurally equal sub-trees are stored once. Both tables are plain arrays
+ *  of little endian 32 bit words, prefixed with offset tables, so a reader
+ *  can use them in place (e.g. from a memory mapped file) and only builds
+ *  the ireps actually asked for. */
+class irep_flat_writert
+{
+public:
+  /// Adds \irep and its sub-trees to the tables, returns its node number
+  unsigned add(const irept &irep);
+
+  /// Number of the string \s in the string table
+  unsigned add_string(const irep_idt &s);
+
+  /// Writes both tables
+  void write(std::ostream &out) const;
+
+  static void write_word(std::ostream &out, uint32_t w);
+
+private:
+  std::unordered_map<unsigned, unsigned> string_numbers;
+  std::vector<irep_idt> strings;
+
+  /// Each node is encoded as: id, #sub, #named, sub..., (name, node)...
+  std::map<std::vector<uint32_t>, unsigned> node_numbers;
+  std::vector<const std::vector<uint32_t> *> nodes;
+
+  /// Number of every irep added, by its shared data, so that a sub-tree
+  /// shared by many ireps is only walked once. The ireps are kept, their data
+  /// must not be freed and reused for another irep.
+  std::unordered_map<const irept::dt *, std::pair<irept, unsigned>>
+    shared_numbers;
+};
+
+/** Reads the tables written by irep_flat_writert without copying them. The
+ *  data must outlive the reader. */
+class irep_flat_readert
+{
+public:
+  /** Parses the tables starting at \data.
+   *  @return a pointer just past them, or nullptr if they are malformed */
+  const uint8_t *open(const uint8_t *data, const uint8_t *end);
+
+  /// Builds (once) and returns node \n; nil if there's no such node
+  const irept &get(unsigned n);
+
+  /// String \n; empty if there's no such string
+  const irep_idt &get_string(unsigned n);
+
+  static uint32_t read_word(const uint8_t *p)
+  {
+    return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) |
+           (uint32_t(p[3]) << 24);
+  }
+
+private:
+  const uint8_t *string_offsets = nullptr;
+  const uint8_t *string_data = nullptr;
+  uint32_t string_count = 0;
+  uint32_t string_bytes = 0;
+
+  const uint8_t *node_offsets = nullptr;
+  const uint8_t *node_data = nullptr;
+  uint32_t node_count = 0;
+  uint32_t node_words = 0;
+
+  std::vector<irep_idt> string_cache;
+  std::vector<bool> string_built;
+  std::vector<irept> node_cache;
+  std::vector<bool> node_built;
+};
+
+#endif /*IREP_FLAT_SERIALIZATION_H_*/
@@ -13,6 +13,13 @@ public:
 
   virtual bool parse(const std::string &path) = 0;
 
+  // whether parse() may run concurrently with that of other instances
+
+  virtual bool parse_is_thread_safe() const
+  {
+    return false;
+  }
+
   // add external dependencies of a given module to set
 
   virtual void dependencies()
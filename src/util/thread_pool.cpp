@@ -0,0 +1,136 @@
+#include <util/thread_pool.h>
+
+work_stealing_pool::work_stealing_pool(size_t workers)
+{
+  if(!workers)
+    workers = default_size();
+
+  for(size_t i = 0; i < workers; i++)
+    queues.emplace_back(std::make_unique<task_queuet>());
+
+  for(size_t i = 0; i < workers; i++)
+    threads.emplace_back(&work_stealing_pool::worker, this, i);
+}
+
+work_stealing_pool::~work_stealing_pool()
+{
+  wait();
+  {
+    std::lock_guard<std::mutex> guard(state_lock);
+    stop = true;
+  }
+  has_work.notify_all();
+
+  for(auto &t : threads)
+    t.join();
+}
+
+size_t work_stealing_pool::default_size() noexcept
+{
+  size_t n = std::thread::hardware_concurrency();
+  return n ? n : 1;
+}
+
+void work_stealing_pool::submit(taskt task)
+{
+  size_t id;
+  {
+    std::lock_guard<std::mutex> guard(state_lock);
+    id = next_queue;
+    next_queue = (next_queue + 1) % queues.size();
+  }
+
+  submit(std::move(task), id);
+}
+
+void work_stealing_pool::submit(taskt task, size_t id)
+{
+  // The task must be visible in a queue before it is announced, so that
+  // a worker which claimed it is guaranteed to find it.
+  {
+    std::lock_guard<std::mutex> guard(queues[id]->lock);
+    queues[id]->tasks.push_back(std::move(task));
+  }
+
+  {
+    std::lock_guard<std::mutex> guard(state_lock);
+    ++queued;
+    ++pending;
+  }
+  has_work.notify_one();
+}
+
+size_t work_stealing_pool::current_worker() const
+{
+  const std::thread::id self = std::this_thread::get_id();
+  for(size_t i = 0; i < threads.size(); i++)
+    if(threads[i].get_id() == self)
+      return i;
+  return threads.size();
+}
+
+void work_stealing_pool::wait()
+{
+  std::unique_lock<std::mutex> guard(state_lock);
+  all_done.wait(guard, [this]() { return pending == 0; });
+}
+
+bool work_stealing_pool::try_pop(size_t id, taskt &task)
+{
+  // Own queue first, newest task (LIFO)
+  {
+    task_queuet &own = *queues[id];
+    std::lock_guard<std::mutex> guard(own.lock);
+    if(!own.tasks.empty())
+    {
+      task = std::move(own.tasks.back());
+      own.tasks.pop_back();
+      return true;
+    }
+  }
+
+  // Then steal the oldest task (FIFO) from someone else
+  for(size_t i = 1; i < queues.size(); i++)
+  {
+    task_queuet &victim = *queues[(id + i) % queues.size()];
+    std::lock_guard<std::mutex> guard(victim.lock);
+    if(!victim.tasks.empty())
+    {
+      task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void work_stealing_pool::worker(size_t id)
+{
+  for(;;)
+  {
+    {
+      std::unique_lock<std::mutex> guard(state_lock);
+      has_work.wait(guard, [this]() { return stop || queued > 0; });
+      if(queued == 0)
+        return;
+      // Claim one task; there are at least as many tasks in the queues as
+      // there are unclaimed announcements, so the search below terminates.
+      --queued;
+    }
+
+    taskt task;
+    while(!try_pop(id, task))
+      std::this_thread::yield();
+
+    task();
+
+    bool done;
+    {
+      std::lock_guard<std::mutex> guard(state_lock);
+      done = --pending == 0;
+    }
+    if(done)
+      all_done.notify_all();
+  }
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Fixed-size pool of worker threads with work stealing.
+ *
+ * Every worker owns a deque of tasks. Submitted tasks are distributed
+ * round-robin over the deques; a worker pops from the back of its own deque
+ * and, once it runs dry, steals from the front of the other workers' deques.
+ * This keeps the number of live threads (and whatever state each task holds)
+ * bounded by the pool size, no matter how many tasks are submitted.
+ *
+ * Tasks must not throw: exceptions should be handled inside the task itself.
+ */
+class work_stealing_pool
+{
+public:
+  typedef std::function<void()> taskt;
+
+  /**
+   * @brief Starts the workers
+   *
+   * @param workers number of worker threads, 0 means default_size()
+   */
+  explicit work_stealing_pool(size_t workers = 0);
+  work_stealing_pool(const work_stealing_pool &) = delete;
+  work_stealing_pool &operator=(const work_stealing_pool &) = delete;
+
+  /// Waits for all pending tasks and joins the workers
+  ~work_stealing_pool();
+
+  /// Queues a task to be executed by one of the workers
+  void submit(taskt task);
+
+  /// Queues a task in the deque of the given worker, which others may steal
+  void submit(taskt task, size_t queue);
+
+  /// Index of the worker running the caller, or size() outside the pool
+  size_t current_worker() const;
+
+  /// Blocks until every task submitted so far has finished
+  void wait();
+
+  size_t size() const noexcept
+  {
+    return threads.size();
+  }
+
+  /// Number of hardware threads, or 1 if it cannot be detected
+  static size_t default_size() noexcept;
+
+private:
+  struct task_queuet
+  {
+    std::mutex lock;
+    std::deque<taskt> tasks;
+  };
+
+  std::vector<std::unique_ptr<task_queuet>> queues;
+  std::vector<std::thread> threads;
+
+  /// Protects every member below
+  std::mutex state_lock;
+  std::condition_variable has_work;
+  std::condition_variable all_done;
+  /// Tasks sitting in some queue which were not claimed by a worker yet
+  size_t queued = 0;
+  /// Tasks either queued or running
+  size_t pending = 0;
+  size_t next_queue = 0;
+  bool stop = false;
+
+  bool try_pop(size_t id, taskt &task);
+  void worker(size_t id);
+};
@@ -8,11 +8,16 @@
  Test Plan:
    - Basic usage scenarios
    - Template based tests
+   - Benchmarks of constant folding, hidden; run them with
+     `biginttest [benchmark]`
  \*******************************************************************/
 
 #define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
 #include <catch2/catch.hpp>
 #include <big-int/bigint.hh>
+#include <cstring>
+#include <vector>
 
 const char *as_string(BigInt const &obj, std::vector<char> &vec)
 {
@@ -218,6 +223,30 @@ TEST_CASE("arbitrary precision integers", "[core][big-int][bigint]")
     REQUIRE(to_string(i) == "1");
   }
 
+  // Numbers up to 128 bits are stored inline, greater ones on the heap.
+  SECTION("inline and heap storage")
+  {
+    const BigInt big("123456789012345678901234567890123456789012345678901");
+    BigInt a(42), b(big);
+
+    a.swap(b);
+    REQUIRE(a == big);
+    REQUIRE(b == 42);
+
+    b = a;
+    a = BigInt(-7);
+    REQUIRE(b == big);
+    REQUIRE(a == -7);
+
+    BigInt c(std::move(b));
+    REQUIRE(c == big);
+
+    c %= BigInt("18446744073709551616");
+    REQUIRE(to_string(c) == "13244928054405786677");
+    c *= c;
+    REQUIRE(to_string(c) == "175428119166385457600438135943230702329");
+  }
+
   // =====================================================================
   // Test cases from the clisp test suite in number.tst.
   // =====================================================================
@@ -331,3 +360,73 @@ TEST_CASE("arbitrary precision integers", "[core][big-int][bigint]")
     }
   }
 }
+
+// What the simplifier does to the values of constant_int2t: mostly 32 and
+// 64 bit operands, folded and then wrapped around to the width of the type
+TEST_CASE("constant folding", "[.][benchmark]")
+{
+  std::vector<BigInt> values;
+  for(uint64_t i = 1; i <= 1000; i++)
+    values.emplace_back(i % 2 ? i * 2654435761u : i * 0x9E3779B97F4A7C15ull);
+  BigInt width32, width64;
+  width32.setPower2(32);
+  width64.setPower2(64);
+
+  BENCHMARK("construct")
+  {
+    uint64_t sum = 0;
+    for(uint64_t i = 0; i < 1000; i++)
+      sum += BigInt(i).to_uint64();
+    return sum;
+  };
+
+  BENCHMARK("copy")
+  {
+    std::vector<BigInt> copy(values);
+    return copy.size();
+  };
+
+  BENCHMARK("add and wrap")
+  {
+    BigInt acc;
+    for(const BigInt &v : values)
+    {
+      acc += v;
+      acc %= width64;
+    }
+    return acc.to_uint64();
+  };
+
+  BENCHMARK("multiply and wrap")
+  {
+    BigInt acc(1);
+    for(const BigInt &v : values)
+      acc = (acc * v) % width32;
+    return acc.to_uint64();
+  };
+
+  BENCHMARK("divide")
+  {
+    uint64_t sum = 0;
+    for(size_t i = 1; i < values.size(); i++)
+      sum += (values[i] / values[i - 1]).to_uint64();
+    return sum;
+  };
+
+  BENCHMARK("compare")
+  {
+    unsigned n = 0;
+    for(size_t i = 1; i < values.size(); i++)
+      n += values[i] < values[i - 1];
+    return n;
+  };
+
+  BENCHMARK("to string")
+  {
+    std::vector<char> buf(64);
+    size_t n = 0;
+    for(const BigInt &v : values)
+      n += strlen(v.as_string(buf.data(), buf.size()));
+    return n;
+  };
+}
@@ -0,0 +1,87 @@
+/*******************************************************************
+ Module: Intrinsics PCH cache unit test
+
+ Test Plan:
+   - A second parse with the same options reuses the cached PCH
+   - Parsing more files doesn't change the cache key
+ \*******************************************************************/
+
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch2/catch.hpp>
+#include <boost/filesystem.hpp>
+#include <clang-c-frontend/clang_c_language.h>
+#include <clang-cpp-frontend/clang_cpp_language.h>
+#include <fstream>
+#include <memory>
+#include <util/cmdline.h>
+#include <util/config.h>
+#include <util/filesystem.h>
+#include <util/options.h>
+
+namespace
+{
+std::vector<boost::filesystem::path> cached_pchs(const std::string &dir)
+{
+  std::vector<boost::filesystem::path> pchs;
+  for(const auto &entry : boost::filesystem::directory_iterator(dir))
+    if(entry.path().extension() == ".pch")
+      pchs.push_back(entry.path());
+  return pchs;
+}
+
+std::string write_file(const std::string &dir, const std::string &name)
+{
+  std::string path = dir + "/" + name;
+  std::ofstream(path) << "int main() { return 0; }\n";
+  return path;
+}
+
+void set_up(const std::string &cache_dir, const std::string &file)
+{
+  cmdlinet cmd;
+  cmd.args.push_back(file);
+  config.set(cmd);
+  config.options.set_option("clang-pch-cache", cache_dir);
+}
+} // namespace
+
+SCENARIO("the intrinsics PCH is reused", "[core][clang-c-frontend][pch]")
+{
+  for(bool cpp : {false, true})
+  {
+    GIVEN(cpp ? "The C++ frontend" : "The C frontend")
+    {
+      auto cache = file_operations::create_tmp_dir("esbmc-test-pch-%%%%-%%%%");
+      auto sources = file_operations::create_tmp_dir("esbmc-test-src-%%%%");
+      auto make_language = [cpp]() {
+        return std::unique_ptr<languaget>(
+          cpp ? new_clang_cpp_language() : new_clang_c_language());
+      };
+      const std::string ext = cpp ? ".cpp" : ".c";
+      std::string first = write_file(sources.path(), "first" + ext);
+      std::string second = write_file(sources.path(), "second" + ext);
+      set_up(cache.path(), first);
+
+      REQUIRE_FALSE(make_language()->parse(first));
+      auto pchs = cached_pchs(cache.path());
+      REQUIRE(pchs.size() == 1);
+      auto built = boost::filesystem::last_write_time(pchs[0]);
+
+      THEN("A second run loads the same PCH")
+      {
+        REQUIRE_FALSE(make_language()->parse(first));
+        pchs = cached_pchs(cache.path());
+        REQUIRE(pchs.size() == 1);
+        REQUIRE(boost::filesystem::last_write_time(pchs[0]) == built);
+      }
+
+      THEN("More files parsed by the same frontend load it too")
+      {
+        auto language = make_language();
+        REQUIRE_FALSE(language->parse(first));
+        REQUIRE_FALSE(language->parse(second));
+        REQUIRE(cached_pchs(cache.path()).size() == 1);
+      }
+    }
+  }
+}
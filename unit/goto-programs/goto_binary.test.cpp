@@ -0,0 +1,171 @@
+/*******************************************************************\
+Module: Unit tests for goto binaries
+
+\*******************************************************************/
+
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch2/catch.hpp>
+#include <goto-programs/read_goto_binary.h>
+#include <goto-programs/write_goto_binary.h>
+#include <irep2/irep2_utils.h>
+#include <sstream>
+#include <util/c_types.h>
+#include <util/expr_util.h>
+#include <util/irep_flat_serialization.h>
+#include <util/migrate.h>
+#include <util/std_expr.h>
+
+namespace
+{
+symbolt make_symbol(const std::string &name, const exprt &value)
+{
+  symbolt s;
+  s.id = name;
+  s.name = name;
+  s.type = value.type();
+  s.value = value;
+  s.lvalue = true;
+  return s;
+}
+} // namespace
+
+TEST_CASE("indexed goto binary round trip", "[core][goto-programs]")
+{
+  contextt ctx;
+  ctx.add(make_symbol("a", gen_one(int_type())));
+  ctx.add(make_symbol("b", symbol_exprt("a", int_type())));
+  ctx.add(make_symbol("c\\with\\backslashes", gen_zero(uint_type())));
+
+  std::ostringstream out;
+  REQUIRE_FALSE(write_goto_binary_indexed(out, ctx));
+  const std::string data = out.str();
+
+  indexed_goto_binaryt index;
+  REQUIRE_FALSE(index.open(data.data(), data.size()));
+  REQUIRE(index.symbols().size() == 3);
+  REQUIRE(index.has_symbol("a"));
+  REQUIRE_FALSE(index.has_symbol("d"));
+
+  // Symbols can be read in any order, independently of each other
+  ctx.foreach_operand([&index](const symbolt &s) {
+    symbolt read;
+    REQUIRE_FALSE(index.read_symbol(s.id, read));
+    REQUIRE(read.id == s.id);
+    REQUIRE(read.type == s.type);
+    REQUIRE(read.value == s.value);
+  });
+
+  symbolt missing;
+  REQUIRE(index.read_symbol("d", missing));
+}
+
+TEST_CASE("plain goto binaries are not indexed", "[core][goto-programs]")
+{
+  const std::string data = "GBF";
+  indexed_goto_binaryt index;
+  REQUIRE(index.open(data.data(), data.size()));
+  REQUIRE(index.symbols().empty());
+}
+
+TEST_CASE("goto binary round trip", "[core][goto-programs]")
+{
+  contextt ctx;
+  ctx.add(make_symbol("a", gen_one(int_type())));
+  ctx.add(make_symbol("b", symbol_exprt("a", int_type())));
+
+  symbolt f;
+  f.id = f.name = "f";
+  f.type = code_typet();
+  ctx.add(f);
+
+  goto_functionst functions;
+  goto_programt &body = functions.function_map["f"].body;
+  functions.function_map["f"].body_available = true;
+  goto_programt::targett skip = body.add_instruction(SKIP);
+  goto_programt::targett loop = body.add_instruction(GOTO);
+  loop->targets.push_back(skip);
+  body.add_instruction(ASSERT)->guard = gen_false_expr();
+  body.add_instruction(END_FUNCTION);
+
+  std::ostringstream out;
+  REQUIRE_FALSE(write_goto_binary(out, ctx, functions));
+  const std::string data = out.str();
+
+  contextt read_ctx;
+  namespacet ns(read_ctx);
+  migrate_namespace_lookup = &ns;
+  goto_functionst read_functions;
+  REQUIRE_FALSE(
+    read_goto_binary_array(data.data(), data.size(), read_ctx, read_functions));
+  migrate_namespace_lookup = nullptr;
+
+  ctx.foreach_operand([&read_ctx](const symbolt &s) {
+    const symbolt *read = read_ctx.find_symbol(s.id);
+    REQUIRE(read != nullptr);
+    REQUIRE(read->type == s.type);
+    REQUIRE(read->value == s.value);
+  });
+
+  REQUIRE(read_functions.function_map.count("f"));
+  const goto_functiont &read_f = read_functions.function_map["f"];
+  REQUIRE(read_f.body_available);
+  REQUIRE(read_f.body.instructions.size() == 4);
+  auto it = read_f.body.instructions.begin();
+  REQUIRE(it->is_skip());
+  REQUIRE((++it)->is_goto());
+  REQUIRE(it->targets.size() == 1);
+  REQUIRE(it->targets.front() == read_f.body.instructions.begin());
+  REQUIRE((++it)->is_assert());
+  REQUIRE(is_false(it->guard));
+  REQUIRE((++it)->is_end_function());
+}
+
+TEST_CASE("truncated goto binaries are rejected", "[core][goto-programs]")
+{
+  contextt ctx;
+  ctx.add(make_symbol("a", gen_one(int_type())));
+  goto_functionst functions;
+
+  std::ostringstream out;
+  REQUIRE_FALSE(write_goto_binary(out, ctx, functions));
+  const std::string data = out.str();
+
+  contextt read_ctx;
+  goto_functionst read_functions;
+  REQUIRE(read_goto_binary_array(
+    data.data(), data.size() - 4, read_ctx, read_functions));
+}
+
+TEST_CASE("shared sub-trees are written once", "[core][goto-programs]")
+{
+  // As a tree, this irep has 2^64 leaves
+  irept node("leaf");
+  for(int i = 0; i < 64; i++)
+  {
+    irept pair("pair");
+    pair.get_sub().push_back(node);
+    pair.get_sub().push_back(node);
+    node = pair;
+  }
+
+  irep_flat_writert writer;
+  unsigned n = writer.add(node);
+  REQUIRE(writer.add(node) == n);
+
+  std::ostringstream out;
+  writer.write(out);
+  const std::string data = out.str();
+  REQUIRE(data.size() < 4096);
+
+  irep_flat_readert reader;
+  const uint8_t *begin = reinterpret_cast<const uint8_t *>(data.data());
+  REQUIRE(reader.open(begin, begin + data.size()) == begin + data.size());
+  const irept *read = &reader.get(n);
+  for(int i = 0; i < 64; i++)
+  {
+    REQUIRE(read->id() == "pair");
+    REQUIRE(read->get_sub().size() == 2);
+    read = &read->get_sub()[1];
+  }
+  REQUIRE(read->id() == "leaf");
+}
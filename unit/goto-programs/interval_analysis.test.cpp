@@ -78,6 +78,14 @@ public:
         ait<interval_domaint> baseline;
         run_test<interval_domaint::int_mapt>(baseline);
       }
+      SECTION("Parallel")
+      {
+        log_status("Parallel");
+        set_baseline_config();
+        ait<interval_domaint> baseline;
+        baseline.set_jobs(2);
+        run_test<interval_domaint::int_mapt>(baseline);
+      }
       // Wrapped Intervals logic (see "Interval Analysis and Machine Arithmetic 2015" paper)
       SECTION("Wrapped Intervals")
       {
@@ -539,6 +547,26 @@ TEST_CASE("Interval Analysis - While Statement", "[ai][interval-analysis]")
   T.run_configs();
 }
 
+TEST_CASE("Interval Analysis - Unbounded Loop", "[ai][interval-analysis]")
+{
+  // Setup global options here
+  ait<interval_domaint> interval_analysis;
+  test_program T;
+  T.code =
+    "int main() {\n"
+    "int a = 0;\n"
+    "while(nondet_int()) {\n" // only converges through widening
+    "a++;\n"
+    "}\n"
+    "return a;\n"
+    "}";
+
+  T.property["6"].push_back({"@F@main@a", 0, true});
+  T.property["6"].push_back({"@F@main@a", 1000, true});
+
+  T.run_configs();
+}
+
 TEST_CASE("Interval Analysis - Add Arithmetic", "[ai][interval-analysis]")
 {
   // Setup global options here
@@ -1064,4 +1092,28 @@ TEST_CASE(
   T.property["6"].push_back({"@F@main@b", -4, false});
 
   T.run_configs();
-}
\ No newline at end of file
+}
+TEST_CASE("Interval Analysis - Calls", "[ai][interval-analysis]")
+{
+  // Setup global options here
+  ait<interval_domaint> interval_analysis;
+
+  test_program T;
+  T.code =
+    "int g;\n"
+    "void inc() { g = g + 1; }\n"
+    "void rec(int n) { if(n) rec(n - 1); }\n"
+    "int main() {\n"
+    "int a = 5;\n"
+    "inc();\n"
+    "rec(a);\n"
+    "int b;\n" // Here "a" should survive both calls
+    "return a;\n"
+    "}";
+
+  T.property["8"].push_back({"@F@main@a", 5, true});
+  T.property["8"].push_back({"@F@main@a", 4, false});
+  T.property["8"].push_back({"@F@main@a", 6, false});
+
+  T.run_configs();
+}
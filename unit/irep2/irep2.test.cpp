@@ -107,11 +107,109 @@ SCENARIO("irep2 hashing", "[core][irep2]")
       {gen_testing_struct(1, 2), gen_ulong(1)},
       {gen_testing_struct(1, 2), gen_ulong(2)},
       {gen_testing_overlap(0), gen_testing_overlap(2)}, // overlap
-      {gen_testing_struct(1, 2), gen_testing_struct(1, 1)}};
+      {gen_testing_struct(1, 2), gen_testing_struct(1, 1)},
+      // Same magnitude
+      {constant_int2tc(get_int_type(32), BigInt(5)),
+       constant_int2tc(get_int_type(32), BigInt(-5))},
+      // Too large to be dumped in a fixed buffer
+      {constant_int2tc(
+         signedbv_type2tc(4096), BigInt(std::string(700, '9').c_str())),
+       constant_int2tc(
+         signedbv_type2tc(4096),
+         BigInt(("8" + std::string(699, '9')).c_str()))}};
     THEN("Expressions and hashes between pairs should not be equal")
     {
       for(auto &e : expressions)
         test_constructed_differently(e.first, e.second);
     }
+    THEN("Their digests on disk should not be equal either")
+    {
+      for(auto &e : expressions)
+      {
+        crypto_hash h1(crypto_hash::enginet::sha1);
+        crypto_hash h2(crypto_hash::enginet::sha1);
+        e.first->hash(h1);
+        e.second->hash(h2);
+        h1.fin();
+        h2.fin();
+        REQUIRE(h1.to_string() != h2.to_string());
+      }
+    }
+  }
+}
+
+// Turns hash-consing on for a scope, even when a REQUIRE throws out of it
+struct interning_scopet
+{
+  interning_scopet()
+  {
+    irep_interningt::enable(true);
+  }
+  ~interning_scopet()
+  {
+    irep_interningt::enable(false);
+  }
+};
+
+SCENARIO("irep2 hash-consing", "[core][irep2]")
+{
+  GIVEN("Hash-consing is enabled")
+  {
+    interning_scopet interning;
+
+    THEN("Identical expressions should share the same node")
+    {
+      // Only const accesses: non-const ones detach shared nodes
+      const expr2tc e1 =
+        add2tc(gen_ulong(1)->type, gen_ulong(1), gen_ulong(2));
+      const expr2tc e2 =
+        add2tc(gen_ulong(1)->type, gen_ulong(1), gen_ulong(2));
+      REQUIRE(e1.get() == e2.get());
+      REQUIRE(e1 == e2);
+
+      const expr2tc s1 = gen_testing_struct(1, 2);
+      const expr2tc s2 = gen_testing_struct(1, 2);
+      REQUIRE(s1.get() == s2.get());
+    }
+    THEN("Different expressions should not be shared")
+    {
+      const expr2tc e1 = gen_testing_struct(1, 2);
+      const expr2tc e2 = gen_testing_struct(1, 1);
+      REQUIRE(e1.get() != e2.get());
+      REQUIRE(e1 != e2);
+    }
+    THEN("Modifying a shared expression should not affect the others")
+    {
+      expr2tc e1 = add2tc(gen_ulong(1)->type, gen_ulong(1), gen_ulong(2));
+      const expr2tc e2 =
+        add2tc(gen_ulong(1)->type, gen_ulong(1), gen_ulong(2));
+      to_add2t(e1).side_2 = gen_ulong(3);
+      REQUIRE(&*e1 != e2.get());
+      REQUIRE(to_add2t(e2).side_2 == gen_ulong(2));
+      REQUIRE(to_add2t(e1).side_2 == gen_ulong(3));
+    }
+    THEN("An unshared node should be modified in place")
+    {
+      expr2tc e1 = add2tc(gen_ulong(1)->type, gen_ulong(7), gen_ulong(11));
+      const expr2t *node = static_cast<const expr2tc &>(e1).get();
+      to_add2t(e1).side_2 = gen_ulong(13);
+      REQUIRE(static_cast<const expr2tc &>(e1).get() == node);
+
+      // The modified node is no longer what the table files it as
+      const expr2tc e2 =
+        add2tc(gen_ulong(1)->type, gen_ulong(7), gen_ulong(11));
+      REQUIRE(e2.get() != node);
+      REQUIRE(to_add2t(e2).side_2 == gen_ulong(11));
+    }
+    THEN("Dead nodes should not be kept alive by the table")
+    {
+      size_t before = irep_interningt::size();
+      {
+        const expr2tc e =
+          add2tc(gen_ulong(1)->type, gen_ulong(17), gen_ulong(19));
+        REQUIRE(irep_interningt::size() > before);
+      }
+      REQUIRE(irep_interningt::size() == before);
+    }
   }
 }
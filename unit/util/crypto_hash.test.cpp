@@ -0,0 +1,141 @@
+/*******************************************************************\
+Module: Unit tests for crypto_hash
+
+The benchmarks are hidden; run them with `cryptohashtest [benchmark]`.
+
+\*******************************************************************/
+
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include <catch2/catch.hpp>
+#include <irep2/irep2_utils.h>
+#include <string>
+#include <util/cache_defs.h>
+#include <util/crypto_hash.h>
+
+namespace
+{
+crypto_hash digest(
+  const std::string &data,
+  crypto_hash::enginet engine = crypto_hash::enginet::fast)
+{
+  crypto_hash h(engine);
+  h.ingest(data.data(), data.size());
+  h.fin();
+  return h;
+}
+
+bool same(const crypto_hash &a, const crypto_hash &b)
+{
+  return !(a < b) && !(b < a);
+}
+
+/// Condition of an assertion as produced by symex: a chain of comparisons
+/// over renamed symbols
+expr2tc make_assertion(unsigned n, unsigned seed)
+{
+  expr2tc e = gen_true_expr();
+  for(unsigned i = 0; i < n; i++)
+  {
+    expr2tc sym = symbol2tc(
+      get_uint32_type(), "c:@x", symbol2t::level2, 0, 0, 1, seed + i);
+    e = and2tc(e, lessthan2tc(sym, gen_ulong(seed * i)));
+  }
+  return e;
+}
+} // namespace
+
+TEST_CASE("sha1 engine", "[core][util][crypto_hash]")
+{
+  REQUIRE(
+    digest("abc", crypto_hash::enginet::sha1).to_string() ==
+    "a9993e364706816aba3e25717850c26c9cd0d89d");
+}
+
+TEST_CASE("fast engine", "[core][util][crypto_hash]")
+{
+  const std::string data = "The quick brown fox jumps over the lazy dog";
+
+  SECTION("is deterministic")
+  {
+    REQUIRE(same(digest(data), digest(data)));
+    REQUIRE(digest(data).hash[4] == 0);
+  }
+
+  SECTION("does not depend on how the data is split")
+  {
+    for(size_t split : {1, 3, 8, 13, 40})
+    {
+      crypto_hash h;
+      h.ingest(data.data(), split);
+      for(size_t i = split; i < data.size(); i++)
+        h.ingest(&data[i], 1);
+      h.fin();
+      REQUIRE(same(h, digest(data)));
+    }
+  }
+
+  SECTION("tells apart similar data")
+  {
+    REQUIRE_FALSE(same(digest(data), digest(data + ".")));
+    REQUIRE_FALSE(same(digest(""), digest(std::string(1, '\0'))));
+    REQUIRE_FALSE(
+      same(digest(std::string(8, '\0')), digest(std::string(16, '\0'))));
+    REQUIRE_FALSE(same(digest("ab"), digest("ba")));
+  }
+
+  SECTION("hashes irep2 expressions")
+  {
+    crypto_hash h1, h2, h3;
+    make_assertion(10, 1)->hash(h1);
+    make_assertion(10, 1)->hash(h2);
+    make_assertion(10, 2)->hash(h3);
+    h1.fin();
+    h2.fin();
+    h3.fin();
+    REQUIRE(same(h1, h2));
+    REQUIRE_FALSE(same(h1, h3));
+  }
+}
+
+TEST_CASE("assertion cache digests", "[.][benchmark]")
+{
+  std::vector<assert_pair> asserts;
+  for(unsigned i = 0; i < 100; i++)
+    asserts.emplace_back(make_assertion(5, i), make_assertion(20, i));
+
+  BENCHMARK("sha1")
+  {
+    size_t h = 0;
+    for(const auto &p : asserts)
+    {
+      crypto_hash h1(crypto_hash::enginet::sha1),
+        h2(crypto_hash::enginet::sha1);
+      p.first->hash(h1);
+      h1.fin();
+      p.second->hash(h2);
+      h2.fin();
+      h ^= h1.to_size_t() ^ h2.to_size_t();
+    }
+    return h;
+  };
+
+  BENCHMARK("fast")
+  {
+    size_t h = 0;
+    for(const auto &p : asserts)
+      h ^= std::hash<assert_pair>()(p);
+    return h;
+  };
+
+  BENCHMARK("assert_db lookups")
+  {
+    assert_db db;
+    for(const auto &p : asserts)
+      db.insert(p);
+    size_t hits = 0;
+    for(const auto &p : asserts)
+      hits += db.count(p);
+    return hits;
+  };
+}
@@ -0,0 +1,134 @@
+/*******************************************************************\
+Module: Unit tests for hamt_mapt
+
+\*******************************************************************/
+
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch2/catch.hpp>
+#include <util/hamt_map.h>
+#include <map>
+#include <string>
+
+namespace
+{
+// Every key collides, which exercises the collision nodes at the bottom
+struct constant_hash
+{
+  size_t operator()(int) const
+  {
+    return 0;
+  }
+};
+
+template <class M>
+std::map<int, int> to_map(const M &m)
+{
+  std::map<int, int> res;
+  for(const auto &it : m)
+    res.emplace(it.first, it.second);
+  return res;
+}
+} // namespace
+
+TEMPLATE_TEST_CASE(
+  "hamt_map behaves like a map",
+  "[core][util][hamt_map]",
+  std::hash<int>,
+  constant_hash)
+{
+  hamt_mapt<int, int, TestType> m;
+  std::map<int, int> ref;
+
+  REQUIRE(m.empty());
+  REQUIRE(m.begin() == m.end());
+
+  for(int i = 0; i < 2000; i++)
+  {
+    int key = (i * 7919) % 1500;
+    auto res = m.emplace(key, i);
+    auto ref_res = ref.emplace(key, i);
+    REQUIRE(res.second == ref_res.second);
+    REQUIRE(*res.first == ref_res.first->second);
+  }
+  REQUIRE(m.size() == ref.size());
+  REQUIRE(to_map(m) == ref);
+
+  for(int i = 0; i < 1500; i += 3)
+  {
+    REQUIRE(m.erase(i));
+    ref.erase(i);
+  }
+  REQUIRE_FALSE(m.erase(0));
+  REQUIRE_FALSE(m.erase(-1));
+  REQUIRE(m.size() == ref.size());
+  REQUIRE(to_map(m) == ref);
+
+  for(int i = 0; i < 1500; i++)
+  {
+    const int *v = m.lookup(i);
+    REQUIRE((v != nullptr) == (ref.count(i) == 1));
+    if(v)
+      REQUIRE(*v == ref[i]);
+  }
+
+  m.clear();
+  REQUIRE(m.empty());
+  REQUIRE(m.lookup(1) == nullptr);
+}
+
+TEMPLATE_TEST_CASE(
+  "hamt_map copies are independent",
+  "[core][util][hamt_map]",
+  std::hash<int>,
+  constant_hash)
+{
+  hamt_mapt<int, int, TestType> a;
+  for(int i = 0; i < 100; i++)
+    a.emplace(i, i);
+
+  hamt_mapt<int, int, TestType> b = a;
+  *b.lookup_mutable(5) = -5;
+  b.set(200, 200);
+  b.erase(7);
+
+  REQUIRE(*a.lookup(5) == 5);
+  REQUIRE(a.lookup(200) == nullptr);
+  REQUIRE(*a.lookup(7) == 7);
+  REQUIRE(a.size() == 100);
+
+  REQUIRE(*b.lookup(5) == -5);
+  REQUIRE(*b.lookup(200) == 200);
+  REQUIRE(b.lookup(7) == nullptr);
+  REQUIRE(b.size() == 100);
+}
+
+TEST_CASE("hamt_map differences skip shared entries", "[core][util][hamt_map]")
+{
+  hamt_mapt<int, int> a;
+  for(int i = 0; i < 1000; i++)
+    a.emplace(i, i);
+
+  hamt_mapt<int, int> b = a;
+  *b.lookup_mutable(10) = 11;
+  b.set(1000, 1000);
+  b.erase(20);
+
+  std::map<int, int> diff;
+  a.for_each_difference(
+    b, [&diff](const std::pair<const int, int> &p) { diff.insert(p); });
+  REQUIRE(diff == std::map<int, int>{{10, 11}, {1000, 1000}});
+
+  diff.clear();
+  a.for_each_difference(
+    a, [&diff](const std::pair<const int, int> &p) { diff.insert(p); });
+  REQUIRE(diff.empty());
+
+  // The callback may modify the map being merged into
+  a.for_each_difference(b, [&a](const std::pair<const int, int> &p) {
+    a.set(p.first, p.second);
+  });
+  REQUIRE(*a.lookup(10) == 11);
+  REQUIRE(*a.lookup(1000) == 1000);
+  REQUIRE(*a.lookup(20) == 20);
+  REQUIRE(a.size() == 1001);
+}
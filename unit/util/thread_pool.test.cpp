@@ -0,0 +1,108 @@
+/*******************************************************************\
+Module: Unit tests for work_stealing_pool
+
+\*******************************************************************/
+
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch2/catch.hpp>
+#include <util/thread_pool.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+
+TEST_CASE("pool executes every submitted task", "[core][util][thread_pool]")
+{
+  std::atomic_size_t counter(0);
+  work_stealing_pool pool(4);
+  REQUIRE(pool.size() == 4);
+
+  for(size_t i = 0; i < 1000; i++)
+    pool.submit([&counter]() { ++counter; });
+
+  pool.wait();
+  REQUIRE(counter == 1000);
+}
+
+TEST_CASE(
+  "pool never runs more tasks than workers at once",
+  "[core][util][thread_pool]")
+{
+  std::atomic_size_t running(0), max_running(0);
+  work_stealing_pool pool(3);
+
+  for(size_t i = 0; i < 200; i++)
+    pool.submit([&running, &max_running]() {
+      size_t now = ++running;
+      size_t seen = max_running;
+      while(now > seen && !max_running.compare_exchange_weak(seen, now))
+        ;
+      std::this_thread::yield();
+      --running;
+    });
+
+  pool.wait();
+  REQUIRE(max_running <= 3);
+  REQUIRE(running == 0);
+}
+
+TEST_CASE(
+  "idle workers steal from busy workers",
+  "[core][util][thread_pool]")
+{
+  work_stealing_pool pool(2);
+  std::atomic_size_t blocked(pool.size()), done(0);
+  std::mutex m;
+  std::set<size_t> workers;
+
+  // Keep one worker busy until the batch has run, or for long enough to
+  // make the test fail rather than hang
+  pool.submit([&pool, &blocked, &done]() {
+    blocked = pool.current_worker();
+    auto until = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while(done < 20 && std::chrono::steady_clock::now() < until)
+      std::this_thread::yield();
+  });
+  while(blocked == pool.size())
+    std::this_thread::yield();
+
+  // Everything goes to the busy worker's own deque, so only stealing runs it
+  for(size_t i = 0; i < 20; i++)
+    pool.submit(
+      [&pool, &m, &workers, &done]() {
+        {
+          std::lock_guard<std::mutex> guard(m);
+          workers.insert(pool.current_worker());
+        }
+        ++done;
+      },
+      blocked);
+
+  pool.wait();
+  REQUIRE(done == 20);
+  REQUIRE(workers.size() == 1);
+  REQUIRE(*workers.begin() != blocked);
+  REQUIRE(*workers.begin() < pool.size());
+}
+
+TEST_CASE("pool can be reused after wait", "[core][util][thread_pool]")
+{
+  std::atomic_size_t counter(0);
+  work_stealing_pool pool(2);
+
+  pool.submit([&counter]() { ++counter; });
+  pool.wait();
+  REQUIRE(counter == 1);
+
+  pool.submit([&counter]() { ++counter; });
+  pool.submit([&counter]() { ++counter; });
+  pool.wait();
+  REQUIRE(counter == 3);
+}
+
+TEST_CASE("default pool size is never zero", "[core][util][thread_pool]")
+{
+  work_stealing_pool pool;
+  REQUIRE(pool.size() == work_stealing_pool::default_size());
+  REQUIRE(pool.size() > 0);
+}